@@ -4,7 +4,7 @@ DiscreteDistribution::DiscreteDistribution() {
     //default constructor
 }
 
-DiscreteDistribution::DiscreteDistribution(vector<int> values) {
+DiscreteDistribution::DiscreteDistribution(const vector<int> &values) {
     //calculate distribution from provided values
 
     if(values.size()==0){
@@ -13,29 +13,24 @@ DiscreteDistribution::DiscreteDistribution(vector<int> values) {
         return;
     }
 
-    //generate unique list of values
+    //count occurrences of each unique value, in ascending order
     sampleSize=values.size();
-    sort(values.begin(),values.end());
-    vector<int> uniqueValues;
-    uniqueValues.clear();
-    uniqueValues.push_back(values[0]);
-    for (int i=1;i<values.size();++i)if (values[i]!=uniqueValues.rbegin()[0]) uniqueValues.push_back(values[i]);
+    map<int,int> counts;
+    for(int i=0; i<values.size(); ++i) ++counts[values[i]];
 
     //set distribution values and size
-    n=uniqueValues.size();
-    x=col_vector<int>(uniqueValues);
+    n=counts.size();
+    x=col_vector<int>(n);
     p_raw=col_vector<double>(n);
     p=col_vector<double>(n);
 
     //calculate probabilities
-    map<int,int> xRef;
-    for(int i=0; i<n; ++i) xRef[x[i]]=i;
-    int ref;
-    for(int i=0; i<values.size(); ++i){
-        ref=xRef[values[i]];
-        p_raw[ref]+=1.0;
+    int ref=0;
+    for(map<int,int>::iterator it=counts.begin(); it!=counts.end(); ++it, ++ref){
+        x[ref]=it->first;
+        p_raw[ref]=it->second;
+        p[ref]=p_raw[ref]/values.size();
     }
-    for(int i=0; i<n; ++i) p=p_raw/values.size();
 
     //calculate mean
     mean=0.0;
@@ -60,6 +55,10 @@ vector<double> DiscreteDistribution::getProbabilities() {
     return probabilities;
 }
 
+size_t DiscreteDistribution::memory() const {
+    return sizeof(DiscreteDistribution)+x.n*sizeof(int)+(p.n+p_raw.n)*sizeof(double);
+}
+
 double DiscreteDistribution::getProbability(int xValue) {
     double probability=0.0;
     for(int i=0; i<n; ++i){
@@ -100,6 +99,10 @@ vector<double> ContinuousDistribution::getValues() {
     return values;
 }
 
+size_t ContinuousDistribution::memory() const {
+    return sizeof(ContinuousDistribution)+x.n*sizeof(double);
+}
+
 vector<double> leastSquaresLinearRegression(vector<double> x, vector<double> y){
     //perform least squares linear regression and return gradient, intercept and r-squared
 
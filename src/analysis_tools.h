@@ -25,13 +25,14 @@ struct DiscreteDistribution{
 
     //constructors, destructors
     DiscreteDistribution(); //default
-    DiscreteDistribution(vector<int> values);
+    DiscreteDistribution(const vector<int> &values);
 
     //getters
     vector<int> getValues();
     vector<int> getRawProbabilities();
     vector<double> getProbabilities();
     double getProbability(int xValue);
+    size_t memory() const; //bytes held
 
 };
 
@@ -51,6 +52,7 @@ struct ContinuousDistribution{
 
     //getters
     vector<double> getValues();
+    size_t memory() const; //bytes held
 };
 
 
@@ -0,0 +1,104 @@
+#include "arena.h"
+
+//##### CONSTRUCTORS, DESTRUCTOR #####
+Arena::Arena() {
+    //default constructor, empty until first allocation
+    block=nullptr;
+    capacity=0;
+    used=0;
+    overflowBytes=0;
+    nGrowths=0;
+}
+
+Arena::Arena(size_t initialCapacity) {
+    //constructor with initial block
+    block=static_cast<char*>(::operator new(initialCapacity));
+    capacity=initialCapacity;
+    used=0;
+    overflowBytes=0;
+    nGrowths=0;
+}
+
+Arena::~Arena() {
+    //destructor
+    release();
+}
+
+Arena::Arena(Arena &&source) {
+    //move constructor, takes blocks from source
+    block=source.block;
+    capacity=source.capacity;
+    used=source.used;
+    overflow=move(source.overflow);
+    overflowBytes=source.overflowBytes;
+    nGrowths=source.nGrowths;
+    source.block=nullptr;
+    source.capacity=0;
+    source.used=0;
+    source.overflow.clear();
+    source.overflowBytes=0;
+}
+
+Arena& Arena::operator=(Arena &&source) {
+    //move assignment, takes blocks from source
+    if(this==&source) return *this;
+    release();
+    block=source.block;
+    capacity=source.capacity;
+    used=source.used;
+    overflow=move(source.overflow);
+    overflowBytes=source.overflowBytes;
+    nGrowths=source.nGrowths;
+    source.block=nullptr;
+    source.capacity=0;
+    source.used=0;
+    source.overflow.clear();
+    source.overflowBytes=0;
+    return *this;
+}
+
+void Arena::release() {
+    //free main and overflow blocks
+    for(int i=0; i<overflow.size(); ++i) ::operator delete(overflow[i]);
+    overflow.clear();
+    overflowBytes=0;
+    if(block!=nullptr) ::operator delete(block);
+    block=nullptr;
+    capacity=0;
+    used=0;
+}
+
+//##### ALLOCATION #####
+void *Arena::allocate(size_t bytes, size_t alignment) {
+    //bump pointer in main block, or new overflow block if exhausted
+    size_t start=(used+alignment-1)/alignment*alignment;
+    if(start+bytes<=capacity){
+        used=start+bytes;
+        return block+start;
+    }
+    char *extra=static_cast<char*>(::operator new(bytes));
+    overflow.push_back(extra);
+    overflowBytes+=bytes;
+    return extra;
+}
+
+void Arena::reset() {
+    //reclaim all memory, if overflowed replace main block with one large enough for whole of last cycle
+    if(overflow.size()>0){
+        size_t required=used+overflowBytes+overflow.size()*alignof(max_align_t);
+        release();
+        capacity=max(2*required,size_t(4096));
+        block=static_cast<char*>(::operator new(capacity));
+        ++nGrowths;
+    }
+    used=0;
+}
+
+//##### GETTERS #####
+size_t Arena::getCapacity() {
+    return capacity;
+}
+
+int Arena::getGrowths() {
+    return nGrowths;
+}
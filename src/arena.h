@@ -0,0 +1,70 @@
+//Monotonic arena for short-lived containers in growth loop, with allocator so standard vectors can draw from it.
+//Memory is only reclaimed on reset, so arena must not be reset while any container using it is alive.
+#ifndef MX2_ARENA_H
+#define MX2_ARENA_H
+
+#include <iostream>
+#include <vector>
+#include <cstddef>
+#include <new>
+#include <algorithm>
+
+using namespace std;
+
+class Arena {
+    //bump allocation from single block, overflow served from extra blocks and merged into main block on reset
+
+private:
+    char *block; //main block
+    size_t capacity, used; //size of main block and bytes taken from it
+    vector<char*> overflow; //extra blocks allocated since last reset
+    size_t overflowBytes; //total size of extra blocks
+    int nGrowths; //number of times main block enlarged
+
+    void release(); //free all blocks
+
+public:
+    //constructors, destructor
+    Arena();
+    Arena(size_t initialCapacity);
+    ~Arena();
+    Arena(const Arena &source)=delete;
+    Arena(Arena &&source);
+    Arena& operator=(const Arena &source)=delete;
+    Arena& operator=(Arena &&source);
+
+    //methods
+    void *allocate(size_t bytes, size_t alignment); //take aligned memory
+    template <typename T> T *allocate(int n); //take memory for n values
+    void reset(); //reclaim all memory, enlarging main block if overflow occurred
+    size_t getCapacity();
+    int getGrowths();
+};
+
+template <typename T>
+struct ArenaAllocator {
+    //allocator drawing from arena, falls back to heap when no arena given
+
+    typedef T value_type;
+    Arena *arena;
+
+    //constructors
+    ArenaAllocator();
+    ArenaAllocator(Arena &a);
+    template <typename U> ArenaAllocator(const ArenaAllocator<U> &source);
+
+    //methods
+    T *allocate(size_t n);
+    void deallocate(T *p, size_t n);
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b);
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b);
+
+template <typename T> using ArenaVector=vector<T,ArenaAllocator<T> >; //vector drawing from arena
+
+#include "arena.tpp"
+
+#endif //MX2_ARENA_H
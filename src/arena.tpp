@@ -0,0 +1,52 @@
+#include "arena.h"
+
+//##### ARENA #####
+template <typename T>
+T *Arena::allocate(int n) {
+    //take uninitialised memory for n values
+    return static_cast<T*>(allocate(n*sizeof(T),alignof(T)));
+}
+
+//##### ARENA ALLOCATOR #####
+template <typename T>
+ArenaAllocator<T>::ArenaAllocator() {
+    //default constructor, heap allocation
+    arena=nullptr;
+}
+
+template <typename T>
+ArenaAllocator<T>::ArenaAllocator(Arena &a) {
+    //constructor, allocate from given arena
+    arena=&a;
+}
+
+template <typename T>
+template <typename U>
+ArenaAllocator<T>::ArenaAllocator(const ArenaAllocator<U> &source) {
+    //rebind from allocator of other type, same arena
+    arena=source.arena;
+}
+
+template <typename T>
+T *ArenaAllocator<T>::allocate(size_t n) {
+    //take memory from arena or heap
+    if(arena==nullptr) return static_cast<T*>(::operator new(n*sizeof(T)));
+    return arena->allocate<T>(n);
+}
+
+template <typename T>
+void ArenaAllocator<T>::deallocate(T *p, size_t) {
+    //arena memory reclaimed only on reset
+    if(arena==nullptr) ::operator delete(p);
+}
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) {
+    //allocators interchangeable if share arena
+    return a.arena==b.arena;
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) {
+    return a.arena!=b.arena;
+}
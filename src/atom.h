@@ -2,20 +2,18 @@
 #define MX2_ATOM_H
 
 #include <iostream>
+#include <cstdint>
 
 template <typename CrdT>
 struct Atom {
-    //contains element, coordinate and unit connectivity information
+    //contains element and coordination information, coordinate held contiguously by network
 
-    int id; //identifier
-    int element; //atomic no.
-    int coordination; //number of bonds
-    CrdT coordinate; //of give type
+    int32_t id; //identifier
+    int16_t element; //atomic no.
+    int16_t coordination; //number of bonds
 
     Atom(); //constructor
     Atom(int idValue, int elem, int cnd); //construct with id, element and coordination
-
-    void setCoordinate(CrdT crd); //set coordinate
 };
 
 #include "atom.tpp"
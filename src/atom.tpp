@@ -13,12 +13,3 @@ Atom<CrdT>::Atom(int idValue, int elem, int cnd) {
     element=elem;
     coordination=cnd;
 }
-
-template <typename CrdT>
-void Atom<CrdT>::setCoordinate(CrdT crd) {
-    //set coordinate with given type
-    coordinate=crd;
-}
-
-
-
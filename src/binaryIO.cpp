@@ -0,0 +1,71 @@
+#include "binaryIO.h"
+
+//##### BINARY WRITER #####
+void BinaryWriter::header(const char *magic, uint32_t version) {
+    //magic, endian tag and version start every container
+    putArray(magic,4);
+    put(endianTag);
+    put(version);
+}
+
+bool BinaryWriter::write(string filename) {
+    //write buffer in single call
+    ofstream file(filename, ios::out|ios::binary|ios::trunc);
+    if(!file.good()) return false;
+    file.write(buffer.data(),buffer.size());
+    file.close();
+    return !file.fail();
+}
+
+//##### BINARY READER #####
+BinaryReader::BinaryReader() {
+    //default constructor
+    position=0;
+    swap=false;
+    valid=false;
+}
+
+bool BinaryReader::read(string filename) {
+    //read whole file in single call
+    ifstream file(filename, ios::in|ios::binary|ios::ate);
+    if(!file.good()) return false;
+    streamsize size=file.tellg();
+    if(size<0) return false;
+    file.seekg(0,ios::beg);
+    buffer.resize(size);
+    if(size>0) file.read(buffer.data(),size);
+    position=0;
+    swap=false;
+    valid=!file.fail();
+    return valid;
+}
+
+bool BinaryReader::header(const char *magic, uint32_t &version) {
+    //check magic, detect byte order from tag and read version
+    char m[4];
+    getArray(m,4);
+    if(!valid || memcmp(m,magic,4)!=0) return false;
+    uint32_t tag=get<uint32_t>();
+    if(tag==endianTag) swap=false;
+    else{
+        swapBytes(tag);
+        if(tag!=endianTag) return false;
+        swap=true;
+    }
+    version=get<uint32_t>();
+    return valid;
+}
+
+size_t BinaryReader::remaining() {
+    //bytes not yet taken
+    return buffer.size()-position;
+}
+
+bool binaryFileHasMagic(string filename, const char *magic) {
+    //peek at first four bytes
+    ifstream file(filename, ios::in|ios::binary);
+    if(!file.good()) return false;
+    char m[4];
+    file.read(m,4);
+    return file.gcount()==4 && memcmp(m,magic,4)==0;
+}
@@ -0,0 +1,53 @@
+//Versioned binary containers, written in native byte order with tag so reader can detect and swap foreign order.
+//Whole file held in buffer, so reading and writing are each a single pass with one system call.
+#ifndef MX2_BINARYIO_H
+#define MX2_BINARYIO_H
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+using namespace std;
+
+const uint32_t endianTag=0x01020304; //reads as 0x04030201 if written in other byte order
+
+struct BinaryWriter {
+    //append values to buffer then write in one go
+
+    vector<char> buffer;
+
+    //methods
+    void header(const char *magic, uint32_t version); //four character magic, endian tag and version
+    template <typename T> void put(T value); //append single value
+    template <typename T> void putArray(const T *values, size_t n); //append array of values
+    bool write(string filename); //write buffer to file, false if cannot
+};
+
+struct BinaryReader {
+    //read file into buffer then take values in order, swapping byte order if tag foreign
+
+    vector<char> buffer;
+    size_t position; //next byte to read
+    bool swap; //file written in other byte order
+    bool valid; //no read past end of buffer
+
+    //constructors
+    BinaryReader();
+
+    //methods
+    bool read(string filename); //read whole file, false if cannot
+    bool header(const char *magic, uint32_t &version); //check magic and endian tag, get version
+    template <typename T> T get(); //take single value
+    template <typename T> void getArray(T *values, size_t n); //take array of values
+    size_t remaining(); //bytes left in buffer
+};
+
+bool binaryFileHasMagic(string filename, const char *magic); //file exists and starts with magic
+
+#include "binaryIO.tpp"
+
+#endif //MX2_BINARYIO_H
@@ -0,0 +1,51 @@
+#include "binaryIO.h"
+
+//##### BYTE ORDER #####
+template <typename T>
+inline void swapBytes(T &value) {
+    //reverse bytes of value
+    char *bytes=reinterpret_cast<char*>(&value);
+    reverse(bytes,bytes+sizeof(T));
+}
+
+//##### BINARY WRITER #####
+template <typename T>
+void BinaryWriter::put(T value) {
+    //append bytes of value
+    putArray(&value,1);
+}
+
+template <typename T>
+void BinaryWriter::putArray(const T *values, size_t n) {
+    //append bytes of values in native order
+    size_t bytes=n*sizeof(T);
+    if(bytes==0) return;
+    size_t start=buffer.size();
+    buffer.resize(start+bytes);
+    memcpy(&buffer[start],values,bytes);
+}
+
+//##### BINARY READER #####
+template <typename T>
+T BinaryReader::get() {
+    //take single value, zero if past end
+    T value=T();
+    getArray(&value,1);
+    return value;
+}
+
+template <typename T>
+void BinaryReader::getArray(T *values, size_t n) {
+    //take values and correct byte order, reader invalidated if not enough bytes remain
+    size_t bytes=n*sizeof(T);
+    if(!valid || bytes>remaining()){
+        valid=false;
+        return;
+    }
+    if(bytes==0) return;
+    memcpy(values,&buffer[position],bytes);
+    position+=bytes;
+    if(swap){
+        for(size_t i=0; i<n; ++i) swapBytes(values[i]);
+    }
+}
@@ -4,21 +4,25 @@
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <utility>
 
 using namespace std;
 
 template <typename T>
 struct col_vector {
-    //column vector of values of fixed size
+    //column vector of values of fixed size, owns values unless constructed as view of external memory
 
     int n;
     T *values;
+    bool owner; //values allocated by and deleted with vector
 
     //constructor, destructor, copyconstructor
     col_vector();
     col_vector(int size);
+    col_vector(T *data, int size); //non-owning view
     col_vector(const col_vector &source);
-    col_vector(const vector<T> &source);
+    col_vector(col_vector &&source) noexcept;
+    template <typename A> col_vector(const vector<T,A> &source);
     ~col_vector();
 
     //operators
@@ -35,7 +39,8 @@ struct col_vector {
     col_vector operator*(const T &k);
     col_vector operator/(const T &k);
     //binary with col_vector
-    void operator=(const col_vector &source);
+    col_vector& operator=(const col_vector &source);
+    col_vector& operator=(col_vector &&source) noexcept;
     void operator+=(const col_vector &source);
     void operator-=(const col_vector &source);
     void operator*=(const col_vector &source);
@@ -54,6 +59,9 @@ struct col_vector {
     double sum();
     double asum();
     double normSq();
+    void addScaled(const col_vector &source, const T &k); //add multiple of vector in place
+    void swap(col_vector &other); //exchange values and ownership
+
 
 };
 
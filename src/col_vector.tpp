@@ -3,9 +3,10 @@
 //##### CONSTRUCTORS, DESTRUCTORS #####
 template <typename T>
 col_vector<T>::col_vector() {
-    //default of size 1
-    n=1;
-    values=new T[n]();
+    //default empty, storage allocated on first assignment
+    n=0;
+    values=nullptr;
+    owner=false;
 }
 
 template <typename T>
@@ -13,6 +14,15 @@ col_vector<T>::col_vector(int size) {
     //use given size
     n=size;
     values=new T[n]();
+    owner=true;
+}
+
+template <typename T>
+col_vector<T>::col_vector(T *data, int size) {
+    //view of external memory, values operated on in place and not deleted
+    n=size;
+    values=data;
+    owner=false;
 }
 
 template <typename T>
@@ -20,21 +30,35 @@ col_vector<T>::col_vector(const col_vector &source) {
     //make deep copy of values
     n=source.n;
     values=new T[n]();
+    owner=true;
     for(int i=0; i<n; ++i) values[i]=source.values[i];
 }
 
 template <typename T>
-col_vector<T>::col_vector(const vector<T> &source) {
+col_vector<T>::col_vector(col_vector &&source) noexcept {
+    //take values from source, leaving it empty
+    n=source.n;
+    values=source.values;
+    owner=source.owner;
+    source.n=0;
+    source.values=nullptr;
+    source.owner=false;
+}
+
+template <typename T>
+template <typename A>
+col_vector<T>::col_vector(const vector<T,A> &source) {
     //make copy from STL vector
     n=source.size();
     values=new T[n]();
+    owner=true;
     for(int i=0; i<n; ++i) values[i]=source[i];
 }
 
 template <typename T>
 col_vector<T>::~col_vector() {
     //clear allocated memory
-    delete[] values;
+    if(owner) delete[] values;
 }
 
 //##### SUBSCRIPTING OPERATORS
@@ -99,15 +123,30 @@ col_vector<T> col_vector<T>::operator/(const T &k) {
 
 //##### BINARY OPERATORS WITH COL VECTOR #####
 template <typename T>
-void col_vector<T>::operator=(const col_vector &source) {
-    if (this == &source) return;
+col_vector<T>& col_vector<T>::operator=(const col_vector &source) {
+    if (this == &source) return *this;
     if(n!=source.n){
-        delete[] values;
+        if(owner) delete[] values;
         n=source.n;
         values=new T[n]();
+        owner=true;
     }
     for(int i=0; i<n; ++i) this->values[i]=source.values[i];
-    return;
+    return *this;
+}
+
+template <typename T>
+col_vector<T>& col_vector<T>::operator=(col_vector &&source) noexcept {
+    //take values from source if both own their memory, otherwise copy so views keep writing in place
+    if (this == &source) return *this;
+    if(!owner || !source.owner) return *this=static_cast<const col_vector&>(source);
+    delete[] values;
+    n=source.n;
+    values=source.values;
+    source.n=0;
+    source.values=nullptr;
+    source.owner=false;
+    return *this;
 }
 
 template <typename T>
@@ -182,3 +221,17 @@ double col_vector<T>::normSq(){
     for(int i=0; i<n; ++i) nSq+=values[i]*values[i];
     return nSq;
 }
+
+template <typename T>
+void col_vector<T>::addScaled(const col_vector &source, const T &k) {
+    //add multiple of vector without temporary
+    for(int i=0; i<n; ++i) values[i]+=source.values[i]*k;
+}
+
+template <typename T>
+void col_vector<T>::swap(col_vector &other) {
+    //exchange values and ownership without copying
+    std::swap(n,other.n);
+    std::swap(values,other.values);
+    std::swap(owner,other.owner);
+}
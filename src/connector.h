@@ -2,23 +2,27 @@
 #define MX2_CONNECTOR_H
 
 #include <iostream>
+#include <cstdint>
 
 using namespace std;
 
+template <int N>
 struct Connector {
-    //holds connectivity information
+    //holds connectivity information, stored inline up to N connections and on heap beyond
 
     //container variables
     int n, max; //number of connections, maximum number of connections
-    int *ids; //list of connections
-    bool full; //whether container is full
+    int *ids; //list of connections, points to inline storage or heap
+    int inlineIds[N]; //inline storage
 
     //constructors, destructors, overloaded operators
     Connector();
     Connector(int maxN);
     ~Connector();
     Connector(const Connector &source);
+    Connector(Connector &&source) noexcept;
     Connector& operator=(const Connector &source);
+    Connector& operator=(Connector &&source) noexcept;
     friend ostream& operator<<(ostream &output, const Connector &source) {
         for (int i = 0; i < source.max; ++i) output << source.ids[i] << " ";
         return output;
@@ -28,6 +32,37 @@ struct Connector {
     int add(int cnx); //add a connection
     int del(int cnx); //delete a connection
     int change(int del, int add); //change connection for another
+    bool full() const; //whether container is full
+    bool onHeap() const; //whether connections stored on heap
+    size_t heapBytes() const; //size of any heap storage
+
+private:
+    void allocate(int maxN); //set up storage for given maximum
+    void release(); //free any heap storage
+};
+
+template <int N>
+struct FixedConnector {
+    //holds up to N connections inline, for nodes of known arity
+
+    //container variables
+    int32_t n; //number of connections
+    int32_t ids[N]; //list of connections
+
+    //constructors, overloaded operators
+    FixedConnector();
+    friend ostream& operator<<(ostream &output, const FixedConnector &source) {
+        for (int i = 0; i < N; ++i) output << source.ids[i] << " ";
+        return output;
+    };
+
+    //methods
+    int add(int cnx); //add a connection
+    int del(int cnx); //delete a connection
+    int change(int del, int add); //change connection for another
+    bool full() const; //whether container is full
 };
 
+#include "connector.tpp"
+
 #endif //MX2_CONNECTOR_H
@@ -0,0 +1,234 @@
+#include "connector.h"
+
+//##### CONNECTOR #####
+template <int N>
+Connector<N>::Connector() {
+    //default constructor
+    n=0;
+    max=0;
+    ids=inlineIds;
+}
+
+template <int N>
+Connector<N>::Connector(int maxN){
+    //constructor
+    n=0;
+    allocate(maxN);
+}
+
+template <int N>
+Connector<N>::~Connector() {
+    //destructor
+    release();
+}
+
+template <int N>
+Connector<N>::Connector(const Connector &source) {
+    //copy constructor
+    n=source.n;
+    allocate(source.max);
+    for(int i=0; i<n; ++i) ids[i]=source.ids[i];
+}
+
+template <int N>
+Connector<N>::Connector(Connector &&source) noexcept {
+    //move constructor, takes heap storage from source
+    n=source.n;
+    max=source.max;
+    if(source.onHeap()){
+        ids=source.ids;
+        source.ids=source.inlineIds;
+        source.max=0;
+    }
+    else{
+        ids=inlineIds;
+        for(int i=0; i<max; ++i) ids[i]=source.ids[i];
+    }
+    source.n=0;
+}
+
+template <int N>
+Connector<N>& Connector<N>::operator=(const Connector &source) {
+    //overload assignment operator
+
+    if (this == &source) return *this;
+
+    //reuse storage if same size
+    if(max!=source.max){
+        release();
+        allocate(source.max);
+    }
+    n=source.n;
+    for(int i=0; i<n; ++i) ids[i]=source.ids[i];
+    for(int i=n; i<max; ++i) ids[i]=0;
+
+    return *this;
+}
+
+template <int N>
+Connector<N>& Connector<N>::operator=(Connector &&source) noexcept {
+    //overload move assignment operator, takes heap storage from source
+
+    if (this == &source) return *this;
+
+    release();
+    n=source.n;
+    max=source.max;
+    if(source.onHeap()){
+        ids=source.ids;
+        source.ids=source.inlineIds;
+        source.max=0;
+    }
+    else{
+        ids=inlineIds;
+        for(int i=0; i<max; ++i) ids[i]=source.ids[i];
+    }
+    source.n=0;
+
+    return *this;
+}
+
+template <int N>
+void Connector<N>::allocate(int maxN) {
+    //set up zeroed storage, inline if small enough
+    max=maxN;
+    if(max>N) ids=new int[max]();
+    else{
+        ids=inlineIds;
+        for(int i=0; i<max; ++i) ids[i]=0;
+    }
+}
+
+template <int N>
+void Connector<N>::release() {
+    //free heap storage and return to inline storage
+    if(onHeap()) delete[] ids;
+    ids=inlineIds;
+    max=0;
+}
+
+template <int N>
+inline bool Connector<N>::full() const {
+    //check if all connections used
+    return n>=max;
+}
+
+template <int N>
+inline size_t Connector<N>::heapBytes() const {
+    //bytes held on heap beyond inline storage
+    return onHeap() ? max*sizeof(int) : 0;
+}
+
+template <int N>
+inline bool Connector<N>::onHeap() const {
+    //check if storage on heap
+    return ids!=inlineIds;
+}
+
+template <int N>
+int Connector<N>::add(int cnx) {
+    //add a connection if not full, check if full after addition
+
+    if(full()) return 1;
+    else{
+        ids[n]=cnx;
+        ++n;
+    }
+
+    return 0;
+}
+
+template <int N>
+int Connector<N>::del(int cnx) {
+    //delete a connection
+
+    int shift=-1;
+    for(int i=0; i<n; ++i){
+        if(ids[i]==cnx){
+            shift=i;
+            --n;
+            break;
+        }
+    }
+    if(shift==-1){
+        return 1;
+    }
+    for(int i=shift; i<n; ++i) ids[i]=ids[i+1];
+    ids[n]=-1;
+
+    return 0;
+}
+
+template <int N>
+int Connector<N>::change(int del, int add) {
+    //change a connection for another
+
+    for(int i=0; i<n; ++i){
+        if(ids[i]==del){
+            ids[i]=add;
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+//##### FIXED CONNECTOR #####
+template <int N>
+FixedConnector<N>::FixedConnector() {
+    //default constructor
+    n=0;
+    for(int i=0; i<N; ++i) ids[i]=0;
+}
+
+template <int N>
+inline bool FixedConnector<N>::full() const {
+    //check if all connections used
+    return n==N;
+}
+
+template <int N>
+int FixedConnector<N>::add(int cnx) {
+    //add a connection if not full
+
+    if(full()) return 1;
+    ids[n]=cnx;
+    ++n;
+
+    return 0;
+}
+
+template <int N>
+int FixedConnector<N>::del(int cnx) {
+    //delete a connection
+
+    int shift=-1;
+    for(int i=0; i<n; ++i){
+        if(ids[i]==cnx){
+            shift=i;
+            --n;
+            break;
+        }
+    }
+    if(shift==-1){
+        return 1;
+    }
+    for(int i=shift; i<n; ++i) ids[i]=ids[i+1];
+    ids[n]=-1;
+
+    return 0;
+}
+
+template <int N>
+int FixedConnector<N>::change(int del, int add) {
+    //change a connection for another
+
+    for(int i=0; i<n; ++i){
+        if(ids[i]==del){
+            ids[i]=add;
+            return 0;
+        }
+    }
+
+    return 1;
+}
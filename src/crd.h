@@ -10,10 +10,21 @@ struct Cart2D {
     //2 dimensional coordinate
 
     //x,y coordinates and initialisation
+    static const int dim=2; //number of components
     double x, y;
     Cart2D();
     Cart2D(double xInit, double yInit);
 
+    //load from and store to contiguous buffer
+    void load(const double *c){
+        x=c[0];
+        y=c[1];
+    }
+    void store(double *c) const{
+        c[0]=x;
+        c[1]=y;
+    }
+
     //overload operators
     Cart2D operator=(const Cart2D &c){
         if(this==&c) return *this;
@@ -83,11 +94,24 @@ struct Cart3D {
     //3 dimensional coordinate
 
     //x,y,z coordinates and initialisation
+    static const int dim=3; //number of components
     double x, y, z;
     Cart3D();
     Cart3D(double xInit, double yInit, double zInit=0.0);
     Cart3D(Cart2D c2d, double zInit=0.0);
 
+    //load from and store to contiguous buffer
+    void load(const double *c){
+        x=c[0];
+        y=c[1];
+        z=c[2];
+    }
+    void store(double *c) const{
+        c[0]=x;
+        c[1]=y;
+        c[2]=z;
+    }
+
     //overload operators
     Cart3D operator=(const Cart3D &c){
         if(this==&c) return *this;
@@ -201,4 +225,21 @@ inline bool lineIntersect2D(double &x0, double &y0, double &x1, double &y1, doub
     return false;
 }
 
+//##### GREAT CIRCLE ARC INTERSECTIONS #######
+inline double tripleProduct(Cart3D &a, Cart3D &b, Cart3D &c){
+    //returns scalar triple product a.(bxc)
+    return a.x*(b.y*c.z-b.z*c.y)+a.y*(b.z*c.x-b.x*c.z)+a.z*(b.x*c.y-b.y*c.x);
+}
+inline bool properIntersectionArcs(Cart3D a, Cart3D b, Cart3D c, Cart3D d, double threshold=1e-12){
+    //returns true if great circle arcs between points projected onto unit sphere properly intersect
+    //each arc must separate end points of other, no point on great circle of other, and crossing not antipodal
+    a.normalise();
+    b.normalise();
+    c.normalise();
+    d.normalise();
+    double s0=tripleProduct(c,a,b), s1=tripleProduct(d,a,b), s2=tripleProduct(a,c,d), s3=tripleProduct(b,c,d);
+    if(fabs(s0)<threshold || fabs(s1)<threshold || fabs(s2)<threshold || fabs(s3)<threshold) return false;
+    return ((s0>0.0)!=(s1>0.0)) && ((s2>0.0)!=(s3>0.0)) && ((s0>0.0)!=(s2>0.0));
+}
+
 #endif //MX2_CRD_H
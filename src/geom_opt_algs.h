@@ -1,9 +1,11 @@
 //Geometry optimisation functors that take a coordinate type and potential model as template parameters
+//Optimisation is carried out in the floating point precision of the potential model, in place on the given coordinates
 #ifndef MX2_GEOM_OPT_ALGS_H
 #define MX2_GEOM_OPT_ALGS_H
 
 #include <iostream>
 #include <limits>
+#include <vector>
 #include "col_vector.h"
 
 using namespace std;
@@ -14,6 +16,7 @@ private:
     int iterationLimit; //maximum iterations
     double lineInc; //line search increment
     double convCriteria; //convergence criteria
+    vector<typename PotModel::Scalar> forceBuffer, incBuffer; //storage for force and increment views, kept between calls
 
 public:
     //constructors
@@ -24,15 +27,21 @@ public:
     void setLineSearchIncrement(double inc);
 
     //function call
-    int operator()(PotModel &model, double &energy, int &iterations, vector<double> &crdsIn);
+    int operator()(PotModel &model, double &energy, int &iterations, col_vector<typename PotModel::Scalar> &crds);
 };
 
+template <typename T>
+T convergenceLimit(double convCriteria, T energy); //energy convergence achievable at given precision
+template <typename T>
+bool coordinatesChanged(col_vector<T> &crds0, col_vector<T> &crds1); //check if line search step had any effect
+
 template <typename PotModel>
 class SteepestDescentArmijo{
 private:
     int iterationLimit; //maximum iterations
     double tau; //line search increment
     double convCriteria; //convergence criteria
+    vector<typename PotModel::Scalar> forceBuffer, incBuffer; //storage for force and trial coordinate views, kept between calls
 
 public:
     //constructors
@@ -40,7 +49,7 @@ public:
     SteepestDescentArmijo(int maxIt, double t, double cc);
 
     //function call
-    int operator()(PotModel &model, double &energy, int &iterations, vector<double> &crdsIn);
+    int operator()(PotModel &model, double &energy, int &iterations, col_vector<typename PotModel::Scalar> &crds);
 };
 
 #include "geom_opt_algs.tpp"
@@ -1,5 +1,19 @@
 #include "geom_opt_algs.h"
 
+//##### PRECISION #####
+template <typename T>
+T convergenceLimit(double convCriteria, T energy) {
+    //energy difference cannot be resolved below a few ulp of energy, so limit convergence criteria
+    return max(T(convCriteria),T(4.0)*numeric_limits<T>::epsilon()*fabs(energy));
+}
+
+template <typename T>
+bool coordinatesChanged(col_vector<T> &crds0, col_vector<T> &crds1) {
+    //check if any coordinate differs, a line search step can underflow to no change at all
+    for(int i=0; i<crds0.n; ++i) if(crds0[i]!=crds1[i]) return true;
+    return false;
+}
+
 //##### STEEPEST DESCENT #####
 template <typename PotModel>
 SteepestDescent<PotModel>::SteepestDescent() {
@@ -22,17 +36,20 @@ void SteepestDescent<PotModel>::setLineSearchIncrement(double inc) {
 }
 
 template <typename PotModel>
-int SteepestDescent<PotModel>::operator()(PotModel &model, double &energy, int &iterations, vector<double> &crdsIn) {
+int SteepestDescent<PotModel>::operator()(PotModel &model, double &energy, int &iterations, col_vector<typename PotModel::Scalar> &crds) {
     //steepest descent algorithm
-    col_vector<double> crds=crdsIn;
-    col_vector<double> force(crds.n);
+    typedef typename PotModel::Scalar T;
+    forceBuffer.resize(crds.n);
+    incBuffer.resize(crds.n);
+    col_vector<T> force(forceBuffer.data(),crds.n); //buffers only grow, so no allocation once largest region seen
 
     //intialise steepest descent parameters
     energy=0.0;
     iterations=0;
-    double previousEnergy=numeric_limits<double>::infinity();
-    double deltaE; //difference between current and previous energy
-    col_vector<double> crdInc; //increment in coordinates for line search
+    T currentEnergy=0.0;
+    T previousEnergy=numeric_limits<T>::infinity();
+    T deltaE; //difference between current and previous energy
+    col_vector<T> crdInc(incBuffer.data(),crds.n); //increment in coordinates for line search
 
     //evaluate force and check non-zero before commencing main loop
     model.calculateForce(crds,force);
@@ -41,15 +58,16 @@ int SteepestDescent<PotModel>::operator()(PotModel &model, double &energy, int &
     //steepest descent algorithm
     for(int i=0; i<iterationLimit; ++i){
         //line search
-        double e0, e1;
-        crdInc=force*lineInc;
+        T e0, e1;
+        crdInc=force;
+        crdInc*=T(lineInc);
         model.calculateEnergy(crds,e0);
         for(;;){
             crds+=crdInc;
             model.calculateEnergy(crds,e1);
             if(e1>e0){//passed through minimum so backtrack
                 crds-=crdInc;
-                energy=e0;
+                currentEnergy=e0;
                 ++iterations;
                 break;
             }
@@ -57,19 +75,17 @@ int SteepestDescent<PotModel>::operator()(PotModel &model, double &energy, int &
         }
 
         //check energy convergence
-        deltaE=fabs(energy-previousEnergy);
-        if(deltaE<convCriteria) break;
-        else previousEnergy=energy;
+        deltaE=fabs(currentEnergy-previousEnergy);
+        if(deltaE<convergenceLimit(convCriteria,currentEnergy)) break;
+        else previousEnergy=currentEnergy;
 
         //recalculate forces
         model.calculateForce(crds,force);
 //        cout<<i<<" "<<energy<<" "<<deltaE<<endl;
     }
+    energy=currentEnergy;
 
     cout<<"iterations "<<iterations<<" energy "<<energy<<endl;
-
-    //update coordinates
-    for(int i=0; i<crds.n; ++i) crdsIn[i]=crds[i];
     return 0;
 }
 
@@ -89,17 +105,22 @@ SteepestDescentArmijo<PotModel>::SteepestDescentArmijo(int maxIt, double t, doub
 }
 
 template <typename PotModel>
-int SteepestDescentArmijo<PotModel>::operator()(PotModel &model, double &energy, int &iterations, vector<double> &crdsIn) {
+int SteepestDescentArmijo<PotModel>::operator()(PotModel &model, double &energy, int &iterations, col_vector<typename PotModel::Scalar> &crds) {
     //steepest descent algorithm
-    col_vector<double> crds=crdsIn;
-    col_vector<double> force(crds.n);
+    typedef typename PotModel::Scalar T;
+    forceBuffer.resize(crds.n);
+    incBuffer.resize(crds.n);
+    col_vector<T> force(forceBuffer.data(),crds.n); //buffers only grow, so no allocation once largest region seen
 
     //intialise steepest descent parameters
     energy=0.0;
     iterations=0;
-    double previousEnergy=numeric_limits<double>::infinity();
-    double deltaE; //difference between current and previous energy
-    col_vector<double> crdInc; //increment in coordinates for line search
+    int status=0; //0 converged or iteration limit, 2 line search stalled at precision limit
+    T currentEnergy=0.0;
+    T previousEnergy=numeric_limits<T>::infinity();
+    T deltaE; //difference between current and previous energy
+    T minAlpha=numeric_limits<T>::epsilon(); //only check for unresolvable steps below this
+    col_vector<T> crdInc(incBuffer.data(),crds.n); //increment in coordinates for line search
 
     //evaluate force and check non-zero before commencing main loop
     model.calculateForce(crds,force);
@@ -108,35 +129,41 @@ int SteepestDescentArmijo<PotModel>::operator()(PotModel &model, double &energy,
     //steepest descent algorithm
     for(int i=0; i<iterationLimit; ++i){
         //backtracking line search
-        double fSq=force.normSq();
-        double alpha=1.0;
-        double e0, e1;
+        T fSq=force.normSq();
+        T alpha=1.0;
+        T e0, e1;
         model.calculateEnergy(crds,e0);
         for(;;){
-            crdInc=crds+force*alpha;
+            crdInc=crds;
+            crdInc.addScaled(force,alpha);
             model.calculateEnergy(crdInc,e1);
             e1+=0.5*alpha*fSq;
             if(e1<e0){
-                energy=e1;
+                currentEnergy=e1;
                 crds=crdInc;
                 ++iterations;
                 break;
             }
+            else if(alpha<minAlpha && !coordinatesChanged(crds,crdInc)){//step no longer resolvable at this precision
+                currentEnergy=e0;
+                status=2;
+                break;
+            }
             else alpha*=tau;
         }
+        if(status==2) break;
+
         //check energy convergence
-        deltaE=fabs(energy-previousEnergy);
-        if(deltaE<convCriteria) break;
-        else previousEnergy=energy;
+        deltaE=fabs(currentEnergy-previousEnergy);
+        if(deltaE<convergenceLimit(convCriteria,currentEnergy)) break;
+        else previousEnergy=currentEnergy;
 
         //recalculate forces
         model.calculateForce(crds,force);
 //        cout<<i<<" "<<energy<<" "<<deltaE<<endl;
     }
+    energy=currentEnergy;
 
 //    cout<<"iterations "<<iterations<<" energy "<<energy<<endl;
-
-    //update coordinates
-    for(int i=0; i<crds.n; ++i) crdsIn[i]=crds[i];
-    return 0;
+    return status;
 }
@@ -0,0 +1,20 @@
+//Position along Hilbert space-filling curve, used to order network species for memory locality
+#ifndef MX2_HILBERT_H
+#define MX2_HILBERT_H
+
+#include <iostream>
+#include <vector>
+#include <array>
+#include <algorithm>
+
+using namespace std;
+
+const int hilbertBits=16; //bits per dimension of quantised coordinates
+
+template <int D>
+unsigned long long hilbertIndex(array<unsigned int,D> x, int bits=hilbertBits); //index of quantised point along curve
+vector<int> hilbertOrder(vector<unsigned long long> &keys); //ids sorted by key, ties kept in id order
+
+#include "hilbert.tpp"
+
+#endif //MX2_HILBERT_H
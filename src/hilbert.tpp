@@ -0,0 +1,41 @@
+#include "hilbert.h"
+
+template <int D>
+unsigned long long hilbertIndex(array<unsigned int,D> x, int bits) {
+    //convert quantised coordinates to transposed hilbert index (Skilling 2004), then interleave bits into single index
+
+    //inverse undo excess work
+    unsigned int m=1u<<(bits-1), p, t;
+    for(unsigned int q=m; q>1; q>>=1){
+        p=q-1;
+        for(int i=0; i<D; ++i){
+            if(x[i]&q) x[0]^=p; //invert
+            else{//exchange
+                t=(x[0]^x[i])&p;
+                x[0]^=t;
+                x[i]^=t;
+            }
+        }
+    }
+
+    //gray encode
+    for(int i=1; i<D; ++i) x[i]^=x[i-1];
+    t=0;
+    for(unsigned int q=m; q>1; q>>=1) if(x[D-1]&q) t^=q-1;
+    for(int i=0; i<D; ++i) x[i]^=t;
+
+    //interleave from most significant bit
+    unsigned long long h=0;
+    for(int b=bits-1; b>=0; --b){
+        for(int i=0; i<D; ++i) h=(h<<1)|((x[i]>>b)&1u);
+    }
+    return h;
+}
+
+inline vector<int> hilbertOrder(vector<unsigned long long> &keys) {
+    //ids sorted by position along curve, stable so ties keep original order
+    vector<int> order(keys.size());
+    for(int i=0; i<order.size(); ++i) order[i]=i;
+    stable_sort(order.begin(),order.end(),[&keys](int a, int b){return keys[a]<keys[b];});
+    return order;
+}
@@ -0,0 +1,82 @@
+#include "intersections.h"
+
+//##### SEGMENT BLOCK #####
+SegmentBlock::SegmentBlock() {
+    //default constructor
+    n=0;
+    extent=0.0;
+}
+
+void SegmentBlock::clear() {
+    //remove segments, storage kept for reuse
+    n=0;
+    x0.clear();
+    y0.clear();
+    x1.clear();
+    y1.clear();
+    tags.clear();
+    extent=0.0;
+}
+
+void SegmentBlock::add(double xA, double yA, double xB, double yB, int tag) {
+    //append segment and widen extent
+    x0.push_back(xA);
+    y0.push_back(yA);
+    x1.push_back(xB);
+    y1.push_back(yB);
+    tags.push_back(tag);
+    extent=max(extent,max(max(fabs(xA),fabs(yA)),max(fabs(xB),fabs(yB))));
+    ++n;
+}
+
+//##### BATCHED TESTS #####
+int properIntersectionsBatch(double xA, double yA, double xB, double yB, const SegmentBlock &block, int begin, int end, vector<unsigned char> &hits) {
+    //test segment A-B against block segments in [begin,end), hits[i-begin] set if proper intersection
+    //orientations in simd lanes use same expression as signedAreaSqTriangle, any lane whose areas lie within
+    //rounding error of collinearity threshold is recomputed by scalar test, so result independent of vectorisation
+
+    int n=end-begin;
+    hits.resize(max(n,0));
+    if(n<=0) return 0;
+
+    //bound on rounding error of orientations, six products of magnitude at most extent squared
+    double extent=max(block.extent,max(max(fabs(xA),fabs(yA)),max(fabs(xB),fabs(yB))));
+    double tolerance=16.0*DBL_EPSILON*extent*extent;
+    double lower=collinearThreshold-tolerance, upper=collinearThreshold+tolerance;
+
+    const double *x0=block.x0.data()+begin, *y0=block.y0.data()+begin;
+    const double *x1=block.x1.data()+begin, *y1=block.y1.data()+begin;
+    unsigned char *hit=hits.data();
+    int nUncertain=0;
+    #pragma omp simd reduction(+:nUncertain)
+    for(int i=0; i<n; ++i){
+        //signed areas of A-B with each end of segment i, and segment i with each of A, B
+        double a0=xA*yB-yA*xB+yA*x0[i]-xA*y0[i]+xB*y0[i]-x0[i]*yB;
+        double a1=xA*yB-yA*xB+yA*x1[i]-xA*y1[i]+xB*y1[i]-x1[i]*yB;
+        double a2=x0[i]*y1[i]-y0[i]*x1[i]+y0[i]*xA-x0[i]*yA+x1[i]*yA-xA*y1[i];
+        double a3=x0[i]*y1[i]-y0[i]*x1[i]+y0[i]*xB-x0[i]*yB+x1[i]*yB-xB*y1[i];
+        double m0=fabs(a0), m1=fabs(a1), m2=fabs(a2), m3=fabs(a3);
+        bool separated=(m0>=collinearThreshold) & (m1>=collinearThreshold) & (m2>=collinearThreshold) & (m3>=collinearThreshold);
+        bool straddle=((a0>0.0)!=(a1>0.0)) & ((a2>0.0)!=(a3>0.0));
+        bool uncertain=((m0>lower) & (m0<upper)) | ((m1>lower) & (m1<upper)) | ((m2>lower) & (m2<upper)) | ((m3>lower) & (m3<upper));
+        hit[i]=uncertain ? 2 : (unsigned char)(separated & straddle);
+        nUncertain+=uncertain;
+    }
+
+    //scalar fallback for lanes near threshold
+    if(nUncertain>0){
+        double x2, y2, x3, y3;
+        for(int i=0; i<n; ++i){
+            if(hit[i]!=2) continue;
+            x2=x0[i];
+            y2=y0[i];
+            x3=x1[i];
+            y3=y1[i];
+            hit[i]=properIntersectionLines(xA,yA,xB,yB,x2,y2,x3,y3);
+        }
+    }
+
+    int nHits=0;
+    for(int i=0; i<n; ++i) nHits+=hit[i];
+    return nHits;
+}
@@ -0,0 +1,35 @@
+//Batched proper intersection tests of line segments, one segment against block held as structure of arrays
+//Orientations evaluated in simd lanes, lanes close to collinearity threshold recomputed with scalar test so results match properIntersectionLines
+#ifndef MX2_INTERSECTIONS_H
+#define MX2_INTERSECTIONS_H
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+#include "crd.h"
+
+using namespace std;
+
+const double collinearThreshold=1e-6; //signed area below which points treated as collinear, as in collinearPoints
+
+struct SegmentBlock {
+    //end points of segments in separate contiguous arrays, with tag for caller to identify each segment
+
+    int n; //number of segments
+    vector<double> x0, y0, x1, y1; //end points
+    vector<int> tags; //caller identifier of segment
+    double extent; //largest absolute coordinate, bounds rounding error of orientations
+
+    //constructors
+    SegmentBlock();
+
+    //methods
+    void clear(); //remove all segments, keeping storage
+    void add(double xA, double yA, double xB, double yB, int tag); //append segment
+};
+
+int properIntersectionsBatch(double xA, double yA, double xB, double yB, const SegmentBlock &block, int begin, int end, vector<unsigned char> &hits); //flag segments in range properly intersecting given segment, returns number
+
+#endif //MX2_INTERSECTIONS_H
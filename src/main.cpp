@@ -23,6 +23,10 @@ int main(){
     readFileSkipLines(inputFile); //skip header
     readFileValue(inputFile,inputPrefix); //for reading in files
     readFileValue(inputFile,outputPrefix); //for writing to files
+    int networkFormat;
+    readFileValue(inputFile,networkFormat); //network files written as text, binary or both
+    int trajectoryInterval;
+    readFileValue(inputFile,trajectoryInterval); //rings between growth trajectory frames
 //    readFileValue(inputFile,rstFrequency); //restart write out frequency
     //Network properties
     int nTotalRings;
@@ -45,7 +49,8 @@ int main(){
     readFileValue(inputFile,randomSeed); //for random number generator
     readFileValue(inputFile,temperature); //for metropolis criteria
     //Potential
-    double kMX, r0MX, kXX, a0XX, kMM, a0MM, kLJ, r0LJ, kC, r0C;
+    double kMX, r0MX, kXX, a0XX, kMM, a0MM, kLJ, r0LJ, kC, r0C, kIX;
+    string repulsion;
     vector<double> potential;
     readFileSkipLines(inputFile,2); //skip
     readFileRowVector(inputFile,potential,2); //M-X
@@ -63,10 +68,12 @@ int main(){
     readFileRowVector(inputFile,potential,2); //Constraints
     kC=potential[0];
     r0C=potential[1];
+    readFileValue(inputFile,repulsion); //repulsion type or table file
+    readFileValue(inputFile,kIX); //intersection penalty
     //Minimisation
     bool preOpt, postOpt;
     vector<bool> globalOpt;
-    int maxIt, localSize;
+    int maxIt, localSize, nThreads, trialPrecision, reorderInterval;
     double lsInc, convTest;
     readFileSkipLines(inputFile,2); //skip
     readFileRowVector(inputFile,globalOpt,2); //perform global optimisation before/after simulation
@@ -74,38 +81,42 @@ int main(){
     readFileValue(inputFile,lsInc); //line search increment
     readFileValue(inputFile,convTest); //convergence test
     readFileValue(inputFile,localSize); //size of local region
+    readFileValue(inputFile,nThreads); //threads for global optimisation
+    readFileValue(inputFile,trialPrecision); //precision of trial ring optimisation
+    readFileValue(inputFile,reorderInterval); //rings between hilbert reordering of network
     preOpt=globalOpt[0];
     postOpt=globalOpt[1];
     //Additional options
-    bool bondDistributions,ringAreas,bilayer,analyseClusters;
+    bool bondDistributions,ringAreas,bilayer,analyseClusters,listOverlaps;
     readFileSkipLines(inputFile,2); //skip
     readFileValue(inputFile,bondDistributions); //explicit distributions
     readFileValue(inputFile,ringAreas); //area of rings
     readFileValue(inputFile,bilayer); //convert to bilayer
     readFileValue(inputFile,analyseClusters); //cluster and percolation analysis
+    readFileValue(inputFile,listOverlaps); //list all overlapping units
     inputFile.close();
 
     //set up simulation of correct geometry
-    if(geometry=="2DC" || geometry=="2DS" || geometry=="2DH") {
+    if(geometry=="2DC" || geometry=="2DS" || geometry=="2DX" || geometry=="2DH" || geometry=="2DP") {
         Simulation<Cart2D, NetworkCart2D> simulation(logfile);
-        simulation.setIO(inputPrefix, outputPrefix, logfile);
+        simulation.setIO(inputPrefix, outputPrefix, networkFormat, trajectoryInterval, logfile);
         simulation.setNP(nTotalRings, minBasicRingSize, maxBasicRingSize, geometry, logfile);
         simulation.setMC(randomSeed, temperature, logfile);
-        simulation.setPM(kMX, r0MX, kXX, a0XX, kMM, a0MM, kLJ, r0LJ, kC, r0C, logfile);
-        simulation.setGO(preOpt, postOpt, maxIt, lsInc, convTest, localSize, logfile);
-        simulation.setFO(bondDistributions,ringAreas,bilayer,analyseClusters,logfile);
+        simulation.setPM(kMX, r0MX, kXX, a0XX, kMM, a0MM, kLJ, r0LJ, kC, r0C, repulsion, kIX, logfile);
+        simulation.setGO(preOpt, postOpt, maxIt, lsInc, convTest, localSize, nThreads, trialPrecision, reorderInterval, logfile);
+        simulation.setFO(bondDistributions,ringAreas,bilayer,analyseClusters,listOverlaps,logfile);
 
         //run simulation
         simulation.run(logfile);
     }
     else if(geometry=="3DS") {
         Simulation<Cart3D, NetworkCart3DS> simulation(logfile);
-        simulation.setIO(inputPrefix, outputPrefix, logfile);
+        simulation.setIO(inputPrefix, outputPrefix, networkFormat, trajectoryInterval, logfile);
         simulation.setNP(nTotalRings, minBasicRingSize, maxBasicRingSize, geometry, logfile);
         simulation.setMC(randomSeed, temperature, logfile);
-        simulation.setPM(kMX, r0MX, kXX, a0XX, kMM, a0MM, kLJ, r0LJ, kC, r0C, logfile);
-        simulation.setGO(preOpt, postOpt, maxIt, lsInc, convTest, localSize, logfile);
-        simulation.setFO(bondDistributions,ringAreas,bilayer,analyseClusters,logfile);
+        simulation.setPM(kMX, r0MX, kXX, a0XX, kMM, a0MM, kLJ, r0LJ, kC, r0C, repulsion, kIX, logfile);
+        simulation.setGO(preOpt, postOpt, maxIt, lsInc, convTest, localSize, nThreads, trialPrecision, reorderInterval, logfile);
+        simulation.setFO(bondDistributions,ringAreas,bilayer,analyseClusters,listOverlaps,logfile);
 
         //run simulation
         simulation.run(logfile);
@@ -15,23 +15,30 @@ MonteCarlo::MonteCarlo(int seed, double temperature, Logfile &logfile) {
     logfile.log("Initialised: ","Monte Carlo, with seed "+to_string(seed),"",1,false);
 }
 
-int MonteCarlo::metropolis(vector<double> energies) {
-    //apply metropolis condition to relative energies
+double MonteCarlo::random() {
+    //draw uniform random number
+    return rand01(mtGen);
+}
+
+int MonteCarlo::metropolis(const ArenaVector<double> &energies) {
+    //apply metropolis condition to relative energies with new random number
+    return metropolis(energies,random());
+}
+
+int MonteCarlo::metropolis(const ArenaVector<double> &energies, double r01) {
+    //apply metropolis condition to relative energies, with given random number so decisions can be compared
     int n = energies.size();
     double lowestEnergy = numeric_limits<double>::infinity();
     for (int i = 0; i < n; ++i) if (energies[i] < lowestEnergy) lowestEnergy = energies[i];
-    vector<double> deltaE = energies;
-    for (int i = 0; i < n; ++i) deltaE[i] -= lowestEnergy;
-    vector<double> probabilities;
+    ArenaVector<double> probabilities(n,0.0,energies.get_allocator()); //drawn from same memory as energies
     double p, pTot = 0.0;
     for (int j = 0; j < n; ++j) {
-        p = exp(-deltaE[j] * rTemperature);
-        probabilities.push_back(p);
+        p = exp(-(energies[j] - lowestEnergy) * rTemperature);
+        probabilities[j] = p;
         pTot += p;
     }
     for (int j = 0; j < n; ++j) probabilities[j] /= pTot;
-    double r01 = rand01(mtGen);
-    int acceptedNetwork;
+    int acceptedNetwork = n - 1; //last if rounding leaves cumulative probability just below r01
     pTot = 0.0;
     for (int j = 0; j < n; ++j) {
         pTot += probabilities[j];
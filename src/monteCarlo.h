@@ -4,6 +4,7 @@
 #include <iostream>
 #include <random>
 #include "logfile.h"
+#include "arena.h"
 
 using namespace std;
 
@@ -20,7 +21,9 @@ public:
     MonteCarlo(int seed, double temperature, Logfile &logfile);
 
     //evaluators
-    int metropolis(vector<double> energies); //return index of selected item
+    double random(); //draw uniform random number in range 0->1
+    int metropolis(const ArenaVector<double> &energies); //return index of selected item
+    int metropolis(const ArenaVector<double> &energies, double r01); //return index of selected item for given random number
 };
 
 
@@ -6,161 +6,46 @@ NetworkCart2D::NetworkCart2D() {
 }
 
 NetworkCart2D::NetworkCart2D(string prefix, Logfile &logfile, double additionalParams):Network<Cart2D>() {
-    //load network from files, except coordinate data
+    //load network from binary or text files
 
-    //set up file names
-    string atomFilename=prefix+"_atoms.out";
-    string unitFilename=prefix+"_units.out";
-    string ringFilename=prefix+"_rings.out";
-    string cnxFilename=prefix+"_connections.out";
-
-    //check files data
+    //load from binary container if present, otherwise from text files
     logfile.log("Loading network","","",0,false);
-    ifstream atomFile(atomFilename, ios::in);
-    ifstream unitFile(unitFilename, ios::in);
-    ifstream ringFile(ringFilename, ios::in);
-    ifstream cnxFile(cnxFilename, ios::in);
-    if(!atomFile.good()) logfile.errorlog("Cannot find atom input file","critical");
-    if(!unitFile.good()) logfile.errorlog("Cannot find unit input file","critical");
-    if(!ringFile.good()) logfile.errorlog("Cannot find ring input file","critical");
-    if(!cnxFile.good()) logfile.errorlog("Cannot find connection input file","critical");
-
-    //read data
-    vector< vector<int> > dataI;
-    vector< vector<double> > dataD;
-
-    //set up all atoms
-    readFileAll(atomFile,dataD);
-    for(int i=0; i<dataD.size();++i){
-        int elem=int(dataD[i][0]);
-        int cnd=int(dataD[i][1]);
-        Cart2D crd = Cart2D(dataD[i][2], dataD[i][3]);
-        Atom<Cart2D> atom(i,elem,cnd);
-        atom.setCoordinate(crd);
-        addAtom(atom);
-    }
-
-    //inital set up of units
-    readFileAll(unitFile,dataI);
-    for(int i=0; i<dataI.size();++i){//set up
-        Unit triangle(i,3,3,3);
-        addUnit(triangle);
-    }
-    for(int i=0; i<dataI.size();++i){//add m atom and unit-atom connections
-        int m=dataI[i][0];
-        units[i].setAtomM(m);
-        for(int j=0; j<3; ++j){
-            addUnitAtomXCnx(i,dataI[i][j+1]);
-        }
-    }
-
-    //initial set up of rings
-    readFileAll(ringFile,dataI);
-    for(int i=0; i<dataI.size();++i){//set up
-        Ring ring(i,dataI[i].size(),dataI[i].size());
-        addRing(ring);
-    }
-    for(int i=0; i<dataI.size();++i){//add unit-ring connections
-        for(int j=0; j<dataI[i].size(); ++j){
-            addUnitRingCnx(dataI[i][j],i);
-        }
-    }
-
-    //add unit-unit connections
-    int n;
-    vector<int> pair;
-    readFileValue(cnxFile,n);
-    for(int i=0; i<n; ++i){
-        readFileRowVector(cnxFile,pair,2);
-        addUnitUnitCnx(pair[0],pair[1]);
-    }
-    //add ring-ring connections
-    readFileValue(cnxFile,n);
-    for(int i=0; i<n; ++i){
-        readFileRowVector(cnxFile,pair,2);
-        addRingRingCnx(pair[0],pair[1]);
+    string binFilename=prefix+networkBinarySuffix;
+    if(binaryFileHasMagic(binFilename,networkMagic)){
+        if(!readBinary(binFilename,additionalParams)) logfile.errorlog("Cannot read binary network file","critical");
+        logfile.log("Network read from: ", binFilename, "", 1, false);
     }
+    else readText(prefix,additionalParams,logfile);
 
     //calculate boundary
     calculateBoundary();
 
-    //close files
-    atomFile.close();
-    unitFile.close();
-    ringFile.close();
-    cnxFile.close();
+    //set up spatial grid
+    initialiseGrid();
 
-    logfile.log("Atoms read from: ", atomFilename, "", 1, false);
-    logfile.log("Units read from: ", unitFilename, "", 1, false);
-    logfile.log("Rings read from: ", ringFilename, "", 1, false);
-    logfile.log("Additional connections read from: ", cnxFilename, "", 1, false);
     logfile.log("Load complete","","",0,true);
 }
 
-int NetworkCart2D::getActiveUnit(string shape, double size) {
+int NetworkCart2D::getActiveUnit(const Shape &shape, double size) {
     //find active unit within given shape, return -1 if cannot find
 
     int unitId=-1;
     int atomId; //id of atom with dangling bond
-
-    if(shape=="C") {//circle
-        double rsq = size * size;
-        for (int i = 0; i < boundaryUnits.size(); ++i) {
-            atomId = boundaryStatus[i];
-            if (atomId >= 0) {
-                if (atoms[atomId].coordinate.normSq() < rsq) {
-                    unitId = boundaryUnits[i];
-                    break;
-                }
-            }
-        }
-    }
-    else if(shape=="S"){
-        Cart2D c;
-        for (int i = 0; i < boundaryUnits.size(); ++i) {
-            atomId = boundaryStatus[i];
-            if (atomId >= 0) {
-                c=atoms[atomId].coordinate;
-                if (c.x < size && c.x > -size && c.y < size && c.y > - size) {
-                    unitId = boundaryUnits[i];
-                    break;
-                }
-            }
-        }
-    }
-    else if(shape=="X"){
-        Cart2D c;
-        for (int i = 0; i < boundaryUnits.size(); ++i) {
-            atomId = boundaryStatus[i];
-            if (atomId >= 0) {
-                c=atoms[atomId].coordinate;
-                if (c.x < size && c.x > 0.0 && c.y < size && c.y > 0.0) {
-                    unitId = boundaryUnits[i];
-                    break;
-                }
-            }
-        }
-    }
-    else if(shape=="H"){
-        Cart2D c;
-        double f;
-        for (int i = 0; i < boundaryUnits.size(); ++i) {
-            atomId = boundaryStatus[i];
-            if (atomId >= 0) {
-                c=atoms[atomId].coordinate;
-                c/=size;
-                f=c.x*c.x+pow((1.25*c.y-sqrt(fabs(c.x))),2);
-                if (f<1) {
-                    unitId = boundaryUnits[i];
-                    break;
-                }
+    Cart2D c;
+    for (int i = 0; i < boundaryUnits.size(); ++i) {
+        atomId = boundaryStatus[i];
+        if (atomId >= 0) {
+            c=getCrd(atomId);
+            if (shape.contains(c.x,c.y,size)) {
+                unitId = boundaryUnits[i];
+                break;
             }
         }
     }
     return unitId;
 }
 
-void NetworkCart2D::popRing0(vector<int> &unitPath) {
+void NetworkCart2D::popRing0(const ArenaVector<int> &unitPath) {
     //remove last built ring (of same size as unit path)
 
     //get ids of x-atoms to dis/reconnect
@@ -183,7 +68,7 @@ void NetworkCart2D::popRing0(vector<int> &unitPath) {
     for(int i=0; i<unitPath.size(); ++i) delUnitRingCnx(unitPath[i],nRings);
 
     //remove ring-ring connections
-    vector<int> nbRings;
+    ArenaVector<int> nbRings(arena);
     nbRings.clear();
     for(int i=0; i<unitPath.size(); ++i){
         for(int j=0; j<units[unitPath[i]].rings.n;++j){
@@ -201,7 +86,7 @@ void NetworkCart2D::popRing0(vector<int> &unitPath) {
     }
 }
 
-void NetworkCart2D::popRing(int ringSize, vector<int> &unitPath) {
+void NetworkCart2D::popRing(int ringSize, const ArenaVector<int> &unitPath) {
     //remove last built ring
 
     //calculate number of species
@@ -229,7 +114,7 @@ void NetworkCart2D::popRing(int ringSize, vector<int> &unitPath) {
     for(int i=0; i<unitPath.size(); ++i) delUnitRingCnx(unitPath[i],nRings);
 
     //remove ring-ring connections
-    vector<int> nbRings;
+    ArenaVector<int> nbRings(arena);
     nbRings.clear();
     for(int i=0; i<unitPath.size(); ++i){
         for(int j=0; j<units[unitPath[i]].rings.n;++j){
@@ -247,7 +132,7 @@ void NetworkCart2D::popRing(int ringSize, vector<int> &unitPath) {
     }
 }
 
-void NetworkCart2D::buildRing0(vector<int> &unitPath) {
+void NetworkCart2D::buildRing0(const ArenaVector<int> &unitPath) {
     //build ring of same size as unit path - change X atom of one unit
 
     //get ids of dangling atoms in path
@@ -270,7 +155,7 @@ void NetworkCart2D::buildRing0(vector<int> &unitPath) {
     //assign ring-units
     for(int i=0; i<unitPath.size(); ++i) addUnitRingCnx(unitPath.rbegin()[i],ringId);
     //assign ring-rings
-    vector<int> nbRings;
+    ArenaVector<int> nbRings(arena);
     nbRings.clear();
     for(int i=0; i<unitPath.size(); ++i){
         for(int j=0; j<units[unitPath[i]].rings.n;++j){
@@ -290,7 +175,7 @@ void NetworkCart2D::buildRing0(vector<int> &unitPath) {
     return;
 }
 
-void NetworkCart2D::buildRing(int ringSize, vector<int> &unitPath, vector<double> &potentialModel) {
+void NetworkCart2D::buildRing(int ringSize, const ArenaVector<int> &unitPath, vector<double> &potentialModel) {
     //build a ring of a given size to a starting path
 
     //calculate number of new species
@@ -302,7 +187,7 @@ void NetworkCart2D::buildRing(int ringSize, vector<int> &unitPath, vector<double
 
     //set up ids for new species
     int ringId=nRings;
-    vector<int> mAtomIds(nNewM), x3AtomIds(nNewX3), x4AtomIds(nNewX4), triIds(nNewTriangles);
+    ArenaVector<int> mAtomIds(nNewM,0,arena), x3AtomIds(nNewX3,0,arena), x4AtomIds(nNewX4,0,arena), triIds(nNewTriangles,0,arena);
     for(int i=0; i<nNewTriangles; ++i) triIds[i]=nUnits+i;
     for(int i=0; i<nNewM; ++i) mAtomIds[i]=nAtoms+i;
     for(int i=0; i<nNewX3; ++i) x3AtomIds[i]=mAtomIds.rbegin()[0]+i+1;
@@ -329,12 +214,12 @@ void NetworkCart2D::buildRing(int ringSize, vector<int> &unitPath, vector<double
 
     //make new triangles
     for(int i=0; i<nNewTriangles; ++i){
-        Unit triangle(nUnits,3,3,3);
+        Unit triangle(nUnits);
         addUnit(triangle);
     }
     //assign m atoms and x3 atoms
     for(int i=0; i<nNewTriangles; ++i){
-        units[triIds[i]].setAtomM(mAtomIds[i]);
+        setUnitAtomM(triIds[i],mAtomIds[i]);
         addUnitAtomXCnx(triIds[i],x3AtomIds[i]);
     }
     //assign x4 atoms
@@ -356,7 +241,7 @@ void NetworkCart2D::buildRing(int ringSize, vector<int> &unitPath, vector<double
     for(int i=0; i<unitPath.size(); ++i) addUnitRingCnx(unitPath.rbegin()[i],ringId);
     for(int i=0; i<nNewTriangles; ++i) addUnitRingCnx(triIds[i],ringId);
     //assign ring-rings
-    vector<int> nbRings;
+    ArenaVector<int> nbRings(arena);
     nbRings.clear();
     for(int i=0; i<unitPath.size(); ++i){
         for(int j=0; j<units[unitPath[i]].rings.n;++j){
@@ -376,11 +261,11 @@ void NetworkCart2D::buildRing(int ringSize, vector<int> &unitPath, vector<double
     //generate new coordinates
     //generate vectors
     Cart2D uvPar, uvPer; //unit vectors parallel and perpendicular to L->R
-    uvPar=atoms[atomIdR].coordinate-atoms[atomIdL].coordinate;
+    uvPar=getCrd(atomIdR)-getCrd(atomIdL);
     Cart2D vClockwise(uvPar.y,-uvPar.x);
     Cart2D vAntiClockwise(-uvPar.y,uvPar.x);
-//    Cart2D dir=atoms[atomIdL].coordinate-atoms[units[unitPath[0]].atomM].coordinate;
-    Cart2D dir=(atoms[atomIdL].coordinate+atoms[atomIdR].coordinate)*0.5;
+//    Cart2D dir=getCrd(atomIdL)-getCrd(units[unitPath[0]].atomM);
+    Cart2D dir=(getCrd(atomIdL)+getCrd(atomIdR))*0.5;
     if(vClockwise*dir>0) uvPer=vClockwise;
     else uvPer=vAntiClockwise;
     double perLen, parLen; //lengths of original perpendicular and parallel vectors
@@ -394,60 +279,60 @@ void NetworkCart2D::buildRing(int ringSize, vector<int> &unitPath, vector<double
         vy=uvPer*potentialModel[3];
         //X4
         int index=0;
-        Cart2D crd=atoms[atomIdL].coordinate;
+        Cart2D crd=getCrd(atomIdL);
         for(int i=0; i<(nNewX4-1)/2; ++i){
             crd+=vy;
-            atoms[x4AtomIds[index]].coordinate=crd;
+            setCrd(x4AtomIds[index],crd);
             ++index;
         }
         crd+=vx*0.5+vy;
-        atoms[x4AtomIds[index]].coordinate=crd;
+        setCrd(x4AtomIds[index],crd);
         ++index;
         crd+=vx*0.5-vy;
         for(int i=0; i<nNewX4/2; ++i){
-            atoms[x4AtomIds[index]].coordinate=crd;
+            setCrd(x4AtomIds[index],crd);
             ++index;
             crd-=vy;
         }
         //M
         index=0;
         vx=uvPar*(parLen+potentialModel[1]);
-        crd=atoms[atomIdL].coordinate-uvPar*potentialModel[1]*0.5+vy*0.5;
+        crd=getCrd(atomIdL)-uvPar*potentialModel[1]*0.5+vy*0.5;
         for(int i=0; i<nNewM/2-1; ++i){
-            atoms[mAtomIds[index]].coordinate=crd;
+            setCrd(mAtomIds[index],crd);
             ++index;
             crd+=vy;
         }
         crd+=vy;
         for(int i=0; i<2; ++i){
             crd+=vx/3.0;
-            atoms[mAtomIds[index]].coordinate=crd;
+            setCrd(mAtomIds[index],crd);
             ++index;
         }
         crd+=vx/3.0-vy*2.0;
         for(int i=0; i<nNewM/2-1; ++i){
-            atoms[mAtomIds[index]].coordinate=crd;
+            setCrd(mAtomIds[index],crd);
             ++index;
             crd-=vy;
         }
         //X3
         index=0;
         vx=uvPar*(parLen+potentialModel[1]*3.0);
-        crd=atoms[atomIdL].coordinate-uvPar*potentialModel[1]*1.5+vy*0.5;
+        crd=getCrd(atomIdL)-uvPar*potentialModel[1]*1.5+vy*0.5;
         for(int i=0; i<nNewX3/2-1; ++i){
-            atoms[x3AtomIds[index]].coordinate=crd;
+            setCrd(x3AtomIds[index],crd);
             ++index;
             crd+=vy;
         }
         crd+=vy*2.0;
         for(int i=0; i<2; ++i){
             crd+=vx/3.0;
-            atoms[x3AtomIds[index]].coordinate=crd;
+            setCrd(x3AtomIds[index],crd);
             ++index;
         }
         crd+=vx/3.0-vy*3.0;
         for(int i=0; i<nNewX3/2-1; ++i){
-            atoms[x3AtomIds[index]].coordinate=crd;
+            setCrd(x3AtomIds[index],crd);
             ++index;
             crd-=vy;
         }
@@ -459,51 +344,51 @@ void NetworkCart2D::buildRing(int ringSize, vector<int> &unitPath, vector<double
         vx=uvPar*parLen;
         vy=uvPer*potentialModel[3];
         //X4
-        Cart2D crd=atoms[atomIdL].coordinate;
+        Cart2D crd=getCrd(atomIdL);
         for(int i=0; i<nNewX4/2; ++i){
             crd+=vy;
-            atoms[x4AtomIds[index]].coordinate=crd;
+            setCrd(x4AtomIds[index],crd);
             ++index;
         }
         crd+=vx;
         for(int i=0; i<nNewX4/2; ++i){
-            atoms[x4AtomIds[index]].coordinate=crd;
+            setCrd(x4AtomIds[index],crd);
             ++index;
             crd-=vy;
         }
         //M
         index=0;
         vx=uvPar*(parLen+potentialModel[1]);
-        crd=atoms[atomIdL].coordinate-uvPar*potentialModel[1]*0.5+vy*0.5;
+        crd=getCrd(atomIdL)-uvPar*potentialModel[1]*0.5+vy*0.5;
         for(int i=0; i<(nNewM-1)/2; ++i){
-            atoms[mAtomIds[index]].coordinate=crd;
+            setCrd(mAtomIds[index],crd);
             ++index;
             crd+=vy;
         }
         crd+=vx*0.5;
-        atoms[mAtomIds[index]].coordinate=crd;
+        setCrd(mAtomIds[index],crd);
         ++index;
         crd+=vx*0.5-vy;
         for(int i=0; i<(nNewM-1)/2; ++i){
-            atoms[mAtomIds[index]].coordinate=crd;
+            setCrd(mAtomIds[index],crd);
             ++index;
             crd-=vy;
         }
         //X3
         index=0;
         vx=uvPar*(parLen+potentialModel[1]*3.0);
-        crd=atoms[atomIdL].coordinate-uvPar*potentialModel[1]*1.5+vy*0.5;
+        crd=getCrd(atomIdL)-uvPar*potentialModel[1]*1.5+vy*0.5;
         for(int i=0; i<(nNewX3-1)/2; ++i){
-            atoms[x3AtomIds[index]].coordinate=crd;
+            setCrd(x3AtomIds[index],crd);
             ++index;
             crd+=vy;
         }
         crd+=vx*0.5+vy;
-        atoms[x3AtomIds[index]].coordinate=crd;
+        setCrd(x3AtomIds[index],crd);
         ++index;
         crd+=vx*0.5-vy*2.0;
         for(int i=0; i<(nNewM-1)/2; ++i){
-            atoms[x3AtomIds[index]].coordinate=crd;
+            setCrd(x3AtomIds[index],crd);
             ++index;
             crd-=vy;
         }
@@ -522,41 +407,41 @@ void NetworkCart2D::writeNetwork(string prefix, Logfile &logfile) {
 
     //write out all atom, unit, ring and connection data
     logfile.log("Writing network","","",0,false);
-    ofstream atomFile(atomFilename, ios::in|ios::trunc);
-    ofstream unitFile(unitFilename, ios::in|ios::trunc);
-    ofstream ringFile(ringFilename, ios::in|ios::trunc);
-    ofstream cnxFile(cnxFilename, ios::in|ios::trunc);
-    ofstream visFile(visFilename, ios::in|ios::trunc);
+    TextWriter atomFile(atomFilename);
+    TextWriter unitFile(unitFilename);
+    TextWriter ringFile(ringFilename);
+    TextWriter cnxFile(cnxFilename);
+    TextWriter visFile(visFilename);
 
     //write atom element, coordination and x-y coordinate
-    atomFile << fixed << showpoint << setprecision(6);
+    atomFile.setFixed(6);
     for(int i=0; i<nAtoms; ++i){
-        atomFile<<atoms[i].element<<"  "<<atoms[i].coordination<<"  "<<atoms[i].coordinate.x<<"  "<<atoms[i].coordinate.y<<endl;
+        atomFile.put(atoms[i].element).put("  ").put(atoms[i].coordination).put("  ").put(getCrd(i).x).put("  ").put(getCrd(i).y).endLine();
     }
     logfile.log("Atoms written to: ", atomFilename, "", 1, false);
 
     //write unit atom ids
     for(int i=0; i<nUnits; ++i){
-        writeFileValue(unitFile,units[i].atomM,false);
-        writeFileArray(unitFile,units[i].atomsX.ids,3,true);
+        writeFileValue(unitFile,topology.unitAtomM[i],false);
+        writeFileArray(unitFile,topology.unitAtomsX.begin(i),3,true);
     }
     logfile.log("Units written to: ", unitFilename, "", 1, false);
 
     //write ring unit geometrical unit ids
     for(int i=0; i<nRings; ++i){
-        writeFileArray(ringFile,rings[i].units.ids,rings[i].units.n,true);
+        writeFileArray(ringFile,topology.ringUnits.begin(i),topology.ringUnits.size(i),true);
     }
     logfile.log("Rings written to: ", ringFilename, "", 1, false);
 
-    //write additional connections
+    //write additional connections, ids match indices after cleaning
     int p0, p1;
     vector<int> pair(2);
     vector< vector<int> > unitUnitCnxs;
     unitUnitCnxs.clear();
     for(int i=0; i<nUnits; ++i){
-        p0=units[i].id;
-        for(int j=0; j<units[i].units.n; ++j){
-            p1=units[units[i].units.ids[j]].id;
+        p0=i;
+        for(int j=0; j<topology.unitUnits.size(i); ++j){
+            p1=topology.unitUnits(i,j);
             if(p0<p1){
                 pair[0]=p0;
                 pair[1]=p1;
@@ -569,9 +454,9 @@ void NetworkCart2D::writeNetwork(string prefix, Logfile &logfile) {
     vector< vector<int> > ringRingCnxs;
     ringRingCnxs.clear();
     for(int i=0; i<nRings; ++i){
-        p0=rings[i].id;
-        for(int j=0; j<rings[i].rings.n; ++j){
-            p1=rings[rings[i].rings.ids[j]].id;
+        p0=i;
+        for(int j=0; j<topology.ringRings.size(i); ++j){
+            p1=topology.ringRings(i,j);
             if(p0<p1){
                 pair[0]=p0;
                 pair[1]=p1;
@@ -606,10 +491,10 @@ void NetworkCart2D::writeNetworkSpecial(string prefix, Logfile &logfile) {
 
     //write out all atom, unit, ring and connection data
     logfile.log("Writing network bilayer","","",0,false);
-    ofstream biFile(bilayerXyzFilename, ios::in|ios::trunc);
-    ofstream biBoundaryFile(bilayerBoundaryFilename, ios::in|ios::trunc);
-    ofstream biHarmFile(bilayerHarmPairsFilename, ios::in|ios::trunc);
-    ofstream biLJFile(bilayerLJPairsFilename, ios::in|ios::trunc);
+    TextWriter biFile(bilayerXyzFilename);
+    TextWriter biBoundaryFile(bilayerBoundaryFilename);
+    TextWriter biHarmFile(bilayerHarmPairsFilename);
+    TextWriter biLJFile(bilayerLJPairsFilename);
 
     //convert to bilayer
     //set up maps, as will order M bottom, M top then X bottom, X middle, X top
@@ -649,25 +534,25 @@ void NetworkCart2D::writeNetworkSpecial(string prefix, Logfile &logfile) {
     bilayerMCrds.clear();
     bilayerXCrds.clear();
     for(int i=0; i<nM; ++i){//M bottom
-        biCrd=Cart3D(atoms[mAtomIds[i]].coordinate*sf,0.0);
+        biCrd=Cart3D(getCrd(mAtomIds[i])*sf,0.0);
         biCrd.z=h-rMX;
         bilayerMCrds.push_back(biCrd);
     }
     for(int i=0; i<nM; ++i){//M top
-        biCrd=Cart3D(atoms[mAtomIds[i]].coordinate*sf,0.0);
+        biCrd=Cart3D(getCrd(mAtomIds[i])*sf,0.0);
         biCrd.z=h+rMX;
         bilayerMCrds.push_back(biCrd);
     }
     for(int i=0; i<nX; ++i){//X bottom
-        biCrd=Cart3D(atoms[xAtomIds[i]].coordinate*sf,0.0);
+        biCrd=Cart3D(getCrd(xAtomIds[i])*sf,0.0);
         bilayerXCrds.push_back(biCrd);
     }
     for(int i=0; i<nM; ++i){//X middle
-        biCrd=Cart3D(atoms[mAtomIds[i]].coordinate*sf,h);
+        biCrd=Cart3D(getCrd(mAtomIds[i])*sf,h);
         bilayerXCrds.push_back(biCrd);
     }
     for(int i=0; i<nX; ++i){//X top
-        biCrd=Cart3D(atoms[xAtomIds[i]].coordinate*sf,2.0*h);
+        biCrd=Cart3D(getCrd(xAtomIds[i])*sf,2.0*h);
         bilayerXCrds.push_back(biCrd);
     }
     //find edge X atoms
@@ -767,12 +652,12 @@ void NetworkCart2D::writeNetworkSpecial(string prefix, Logfile &logfile) {
         harmXX.push_back(xU2);
     }
     //write to files
-    biFile << fixed << showpoint << setprecision(6);
+    biFile.setFixed(6);
     writeFileValue(biFile,nBiM+nBiX,true);
     writeFileValue(biFile,"",true);
     double crdShift=500.0;
-    for(int i=0; i<bilayerMCrds.size(); ++i) biFile<<"Si"<<i+1<<"    "<<bilayerMCrds[i].x+crdShift<<"     "<<bilayerMCrds[i].y+crdShift<<"     "<<bilayerMCrds[i].z+crdShift<<"     "<<endl;
-    for(int i=0; i<bilayerXCrds.size(); ++i) biFile<<"O"<<i+nBiM+1<<"    "<<bilayerXCrds[i].x+crdShift<<"     "<<bilayerXCrds[i].y+crdShift<<"     "<<bilayerXCrds[i].z+crdShift<<"     "<<endl;
+    for(int i=0; i<bilayerMCrds.size(); ++i) biFile.put("Si").put(i+1).put("    ").put(bilayerMCrds[i].x+crdShift).put("     ").put(bilayerMCrds[i].y+crdShift).put("     ").put(bilayerMCrds[i].z+crdShift).put("     ").endLine();
+    for(int i=0; i<bilayerXCrds.size(); ++i) biFile.put("O").put(i+nBiM+1).put("    ").put(bilayerXCrds[i].x+crdShift).put("     ").put(bilayerXCrds[i].y+crdShift).put("     ").put(bilayerXCrds[i].z+crdShift).put("     ").endLine();
 //    for(int i=0; i<bilayerMCrds.size(); ++i) biFile<<"Si"<<"    "<<bilayerMCrds[i].x<<"     "<<bilayerMCrds[i].y<<"     "<<bilayerMCrds[i].z<<"     "<<endl;
 //    for(int i=0; i<bilayerXCrds.size(); ++i) biFile<<"O"<<"    "<<bilayerXCrds[i].x<<"     "<<bilayerXCrds[i].y<<"     "<<bilayerXCrds[i].z<<"     "<<endl;
     writeFileValue(biBoundaryFile,danglingX.size()/2,true);
@@ -796,74 +681,34 @@ void NetworkCart2D::writeNetworkSpecial(string prefix, Logfile &logfile) {
 }
 
 
-void NetworkCart2D::setGO(int it, double ls, double conv, int loc) {
+void NetworkCart2D::setGO(int it, double ls, double conv, int loc, int threads) {
     //set up optimiser with geometry optimisation parameters
     localExtent=loc;
+    globalThreads=threads;
     defLineInc=ls;
-    optimiser=SteepestDescentArmijo<HLJC2>(it,ls,conv);
-}
-
-vector<double> NetworkCart2D::getCrds() {
-    //get all atom coordinates collapsed onto 1d
-    vector<double> crds;
-    crds.clear();
-    for(int i=0; i<nAtoms; ++i){
-        crds.push_back(atoms[i].coordinate.x);
-        crds.push_back(atoms[i].coordinate.y);
-    }
-    return crds;
-}
-
-vector<double> NetworkCart2D::getCrds(map<int, int> &globalAtomMap, int n) {
-    //get local atom coordinates collapsed onto 1d
-    vector<double> crds;
-    crds.clear();
-    int id;
-    for(int i=0; i<n; ++i){
-        id=globalAtomMap.at(i);
-        crds.push_back(atoms[id].coordinate.x);
-        crds.push_back(atoms[id].coordinate.y);
-    }
-    return crds;
-}
-
-void NetworkCart2D::setCrds(vector<double> &crds) {
-    //set all atom coordinates
-    for(int i=0; i<nAtoms; ++i){
-        atoms[i].coordinate.x=crds[2*i];
-        atoms[i].coordinate.y=crds[2*i+1];
-    }
-}
-
-void NetworkCart2D::setCrds(map<int, int> &globalAtomMap, vector<double> &crds) {
-    //set local atom coordinates
-    int n=crds.size()/2;
-    int id;
-    for(int i=0; i<n; ++i){
-        id=globalAtomMap.at(i);
-        atoms[id].coordinate.x=crds[2*i];
-        atoms[id].coordinate.y=crds[2*i+1];
-    }
+    optimiser=SteepestDescentArmijo< HLJC2<double> >(it,ls,conv);
+    optimiserSP=SteepestDescentArmijo< HLJC2<float> >(it,ls,conv);
 }
 
 void NetworkCart2D::geometryOptimiseGlobal(vector<double> &potentialModel) {
     //set up harmonic potential before passing to derived class
 
     //reset potential information - don't need angles for harmonic potential
-    vector<int> bonds, angles, repulsions, fixedAtoms, interx;
-    vector<double>  bondK, bondR0, repK, repR0, crds;
+    ArenaVector<int> bonds, angles, repulsions, fixedAtoms, interx;
+    ArenaVector<int> bondTypes; //type code for each bond, M-X 0 and X-X 1
+    ArenaVector<double> bondK, bondR0; //parameters for each bond type
     bonds.clear();
     angles.clear();
     repulsions.clear();
     fixedAtoms.clear();
     interx.clear();
+    bondTypes.clear();
     bondK.clear();
     bondR0.clear();
-    repK.clear();
-    repR0.clear();
-
-    //get all atom coordinates
-    crds=getCrds();
+    bondK.push_back(potentialModel[0]);
+    bondR0.push_back(potentialModel[1]);
+    bondK.push_back(potentialModel[2]);
+    bondR0.push_back(potentialModel[3]);
 
     //loop over triangle units to get M-X, X-X bonds
     int mId0, xId0, xId1, xId2;
@@ -875,43 +720,25 @@ void NetworkCart2D::geometryOptimiseGlobal(vector<double> &potentialModel) {
         //M-X
         bonds.push_back(mId0);
         bonds.push_back(xId0);
-        bondK.push_back(potentialModel[0]);
-        bondR0.push_back(potentialModel[1]);
+        bondTypes.push_back(0);
         bonds.push_back(mId0);
         bonds.push_back(xId1);
-        bondK.push_back(potentialModel[0]);
-        bondR0.push_back(potentialModel[1]);
+        bondTypes.push_back(0);
         bonds.push_back(mId0);
         bonds.push_back(xId2);
-        bondK.push_back(potentialModel[0]);
-        bondR0.push_back(potentialModel[1]);
+        bondTypes.push_back(0);
         //X-X
         bonds.push_back(xId0);
         bonds.push_back(xId1);
-        bondK.push_back(potentialModel[2]);
-        bondR0.push_back(potentialModel[3]);
+        bondTypes.push_back(1);
         bonds.push_back(xId0);
         bonds.push_back(xId2);
-        bondK.push_back(potentialModel[2]);
-        bondR0.push_back(potentialModel[3]);
+        bondTypes.push_back(1);
         bonds.push_back(xId1);
         bonds.push_back(xId2);
-        bondK.push_back(potentialModel[2]);
-        bondR0.push_back(potentialModel[3]);
+        bondTypes.push_back(1);
     }
 
-    //loop over all m atoms and add M-M LJ interactions
-    int mId1;
-    for(int i=0; i<nUnits-1;++i){
-        mId0=units[i].atomM;
-        for(int j=i+1; j<nUnits; ++j){
-            mId1=units[j].atomM;
-            repulsions.push_back(mId0);
-            repulsions.push_back(mId1);
-            repK.push_back(potentialModel[6]);
-            repR0.push_back(potentialModel[7]);
-        }
-    }
 
 //    //loop over neighbour triangle units to get M-M
 //    int mId1;
@@ -945,119 +772,115 @@ void NetworkCart2D::geometryOptimiseGlobal(vector<double> &potentialModel) {
 //        }
 //    }
 
-    //set up model and optimise
-    HLJC2 potential(bonds, angles, repulsions, bondK, bondR0, repK, repR0, fixedAtoms, interx);
+    //set up model and optimise, with M-M LJ interactions only between m atoms within cutoff plus skin
+    //list regenerated from grid whenever any atom moves over half the skin, so no interacting pair is missed
+    double cutoff=repulsionCutoff(potentialModel[7]);
+    double range=cutoff*(1.0+neighbourSkin);
+    grid.build(atomCrds);
+    findRepulsions(atomCrds.data(),range,repulsions);
+    HLJC2<double> potential(bonds, angles, repulsions, fixedAtoms, interx, bondTypes, bondK, bondR0, potentialModel[6], potentialModel[7]);
+    if(!repTable.empty()) potential.setRepulsionTable(&repTable);
+    potential.setThreads(globalThreads);
+    col_vector<double> crds(atomCrds.data(),atomCrds.size()); //view of coordinate buffer, optimised in place
+    potential.setNeighbourUpdate([this,range](col_vector<double> &c, ArenaVector<int> &rep){
+        grid.build(c.values,c.n/Cart2D::dim);
+        findRepulsions(c.values,range,rep);
+    },0.5*(range-cutoff),crds);
     optimiser(potential, energy, optIterations, crds);
-
-    //update coordinates
-    setCrds(crds);
+    grid.build(atomCrds);
+    measureUnitReach();
 }
 
-void NetworkCart2D::geometryOptimiseLocal(vector<double> &potentialModel) {
+void NetworkCart2D::geometryOptimiseLocal(vector<double> &potentialModel, bool singlePrecision) {
     //geometry optimise atoms only in local region
 
     //reset potential information - don't need angles for harmonic potential
-    vector<int> bonds, angles, repulsions, interx;
-    vector<double>  bondK, bondR0, repK, repR0, crds;
+    ArenaVector<int> bonds(arena), angles(arena), repulsions(arena), interx(arena);
+    ArenaVector<int> bondTypes(arena); //type code for each bond, M-X 0 and X-X 1
+    ArenaVector<double> bondK(arena), bondR0(arena); //parameters for each bond type
     bonds.clear();
     angles.clear();
     repulsions.clear();
     interx.clear();
+    bondTypes.clear();
     bondK.clear();
     bondR0.clear();
-    repK.clear();
-    repR0.clear();
+    bondK.push_back(potentialModel[0]);
+    bondR0.push_back(potentialModel[1]);
+    bondK.push_back(potentialModel[2]);
+    bondR0.push_back(potentialModel[3]);
 
     //get local region
     findLocalRegion(rings.rbegin()[0].id,localExtent);
 
-    //get local atom coordinates
-    crds=getCrds(globalAtomMap,nLocalAtoms);
-
     //loop over triangle units to get M-X, X-X bonds
     int mId0, xId0, xId1, xId2;
     for(int i=0; i<flexLocalUnits.size(); ++i){
-        mId0=localAtomMap.at(units[flexLocalUnits[i]].atomM);
-        xId0=localAtomMap.at(units[flexLocalUnits[i]].atomsX.ids[0]);
-        xId1=localAtomMap.at(units[flexLocalUnits[i]].atomsX.ids[1]);
-        xId2=localAtomMap.at(units[flexLocalUnits[i]].atomsX.ids[2]);
+        mId0=localAtomMap[units[flexLocalUnits[i]].atomM];
+        xId0=localAtomMap[units[flexLocalUnits[i]].atomsX.ids[0]];
+        xId1=localAtomMap[units[flexLocalUnits[i]].atomsX.ids[1]];
+        xId2=localAtomMap[units[flexLocalUnits[i]].atomsX.ids[2]];
         //M-X
         bonds.push_back(mId0);
         bonds.push_back(xId0);
-        bondK.push_back(potentialModel[0]);
-        bondR0.push_back(potentialModel[1]);
+        bondTypes.push_back(0);
         bonds.push_back(mId0);
         bonds.push_back(xId1);
-        bondK.push_back(potentialModel[0]);
-        bondR0.push_back(potentialModel[1]);
+        bondTypes.push_back(0);
         bonds.push_back(mId0);
         bonds.push_back(xId2);
-        bondK.push_back(potentialModel[0]);
-        bondR0.push_back(potentialModel[1]);
+        bondTypes.push_back(0);
         //X-X
         bonds.push_back(xId0);
         bonds.push_back(xId1);
-        bondK.push_back(potentialModel[2]);
-        bondR0.push_back(potentialModel[3]);
+        bondTypes.push_back(1);
         bonds.push_back(xId0);
         bonds.push_back(xId2);
-        bondK.push_back(potentialModel[2]);
-        bondR0.push_back(potentialModel[3]);
+        bondTypes.push_back(1);
         bonds.push_back(xId1);
         bonds.push_back(xId2);
-        bondK.push_back(potentialModel[2]);
-        bondR0.push_back(potentialModel[3]);
+        bondTypes.push_back(1);
     }
     for(int i=0; i<fixedLocalUnits.size(); ++i){
-        mId0=localAtomMap.at(units[fixedLocalUnits[i]].atomM);
-        xId0=localAtomMap.at(units[fixedLocalUnits[i]].atomsX.ids[0]);
-        xId1=localAtomMap.at(units[fixedLocalUnits[i]].atomsX.ids[1]);
-        xId2=localAtomMap.at(units[fixedLocalUnits[i]].atomsX.ids[2]);
+        mId0=localAtomMap[units[fixedLocalUnits[i]].atomM];
+        xId0=localAtomMap[units[fixedLocalUnits[i]].atomsX.ids[0]];
+        xId1=localAtomMap[units[fixedLocalUnits[i]].atomsX.ids[1]];
+        xId2=localAtomMap[units[fixedLocalUnits[i]].atomsX.ids[2]];
         //M-X
         bonds.push_back(mId0);
         bonds.push_back(xId0);
-        bondK.push_back(potentialModel[0]);
-        bondR0.push_back(potentialModel[1]);
+        bondTypes.push_back(0);
         bonds.push_back(mId0);
         bonds.push_back(xId1);
-        bondK.push_back(potentialModel[0]);
-        bondR0.push_back(potentialModel[1]);
+        bondTypes.push_back(0);
         bonds.push_back(mId0);
         bonds.push_back(xId2);
-        bondK.push_back(potentialModel[0]);
-        bondR0.push_back(potentialModel[1]);
+        bondTypes.push_back(0);
         //X-X
         bonds.push_back(xId0);
         bonds.push_back(xId1);
-        bondK.push_back(potentialModel[2]);
-        bondR0.push_back(potentialModel[3]);
+        bondTypes.push_back(1);
         bonds.push_back(xId0);
         bonds.push_back(xId2);
-        bondK.push_back(potentialModel[2]);
-        bondR0.push_back(potentialModel[3]);
+        bondTypes.push_back(1);
         bonds.push_back(xId1);
         bonds.push_back(xId2);
-        bondK.push_back(potentialModel[2]);
-        bondR0.push_back(potentialModel[3]);
+        bondTypes.push_back(1);
     }
 
     //loop over m atoms and add M-M LJ interactions
     int mId1;
     for(int i=0; i<flexLocalUnits.size()-1;++i){
-        mId0=localAtomMap.at(units[flexLocalUnits[i]].atomM);
+        mId0=localAtomMap[units[flexLocalUnits[i]].atomM];
         for(int j=i+1; j<flexLocalUnits.size(); ++j){
-            mId1=localAtomMap.at(units[flexLocalUnits[j]].atomM);
+            mId1=localAtomMap[units[flexLocalUnits[j]].atomM];
             repulsions.push_back(mId0);
             repulsions.push_back(mId1);
-            repK.push_back(potentialModel[6]);
-            repR0.push_back(potentialModel[7]);
         }
         for(int j=0; j<fixedLocalUnits.size(); ++j){
-            mId1=localAtomMap.at(units[fixedLocalUnits[j]].atomM);
+            mId1=localAtomMap[units[fixedLocalUnits[j]].atomM];
             repulsions.push_back(mId0);
             repulsions.push_back(mId1);
-            repK.push_back(potentialModel[6]);
-            repR0.push_back(potentialModel[7]);
         }
     }
 
@@ -1134,54 +957,35 @@ void NetworkCart2D::geometryOptimiseLocal(vector<double> &potentialModel) {
 //        }
 //    }
 
-    //set up model and optimise, alter line search increment if insufficient iterations
-    HLJC2 potential(bonds,angles, repulsions, bondK, bondR0, repK, repR0, fixedLocalAtoms, interx);
-    optimiser(potential, energy, optIterations, crds);
-
-    //update coordinates
-    setCrds(globalAtomMap,crds);
+    //add soft penalty between nearby edges of local units, if requested
+    if(potentialModel[10]>0.0) findLocalInterx(interx);
+
+    //set up model and optimise local coordinates, in single precision if requested
+    ArenaVector<int> fixedAtoms(fixedLocalAtoms.begin(),fixedLocalAtoms.end(),arena);
+    if(singlePrecision){
+        HLJC2<float> potential(bonds,angles, repulsions, fixedAtoms, interx, bondTypes, bondK, bondR0, potentialModel[6], potentialModel[7]);
+        if(!repTableSP.empty()) potential.setRepulsionTable(&repTableSP);
+        potential.setIntersectionPenalty(potentialModel[10]);
+        col_vector<float> crds(arena.allocate<float>(2*nLocalAtoms),2*nLocalAtoms);
+        getCrds(globalAtomMap,crds);
+        optimiserSP(potential, energy, optIterations, crds);
+        setCrds(globalAtomMap,crds);
+    }
+    else{
+        HLJC2<double> potential(bonds,angles, repulsions, fixedAtoms, interx, bondTypes, bondK, bondR0, potentialModel[6], potentialModel[7]);
+        if(!repTable.empty()) potential.setRepulsionTable(&repTable);
+        potential.setIntersectionPenalty(potentialModel[10]);
+        col_vector<double> crds(arena.allocate<double>(2*nLocalAtoms),2*nLocalAtoms);
+        getCrds(globalAtomMap,crds);
+        optimiser(potential, energy, optIterations, crds);
+        setCrds(globalAtomMap,crds);
+    }
+    raiseLocalUnitReach();
 }
 
-void NetworkCart2D::checkOverlap() {
+void NetworkCart2D::checkOverlap(bool listAll) {
     //check for overlap of any triangles
-
-    unitOverlap=false;
-
-    //make list of all lines that make up triangles
-    int a, b, c;
-    vector<int> lines;
-    lines.clear();
-    for(int i=0; i<nUnits; ++i){
-        a=units[i].atomsX.ids[0];
-        b=units[i].atomsX.ids[1];
-        c=units[i].atomsX.ids[2];
-        lines.push_back(a);
-        lines.push_back(b);
-        lines.push_back(a);
-        lines.push_back(c);
-        lines.push_back(b);
-        lines.push_back(c);
-    }
-
-    //check overlap of all pairs of lines
-    int n=lines.size()/2;
-    double x0,x1,x2,x3,y0,y1,y2,y3;
-    for(int i=0; i<n-1; ++i){
-        x0=atoms[lines[2*i]].coordinate.x;
-        y0=atoms[lines[2*i]].coordinate.y;
-        x1=atoms[lines[2*i+1]].coordinate.x;
-        y1=atoms[lines[2*i+1]].coordinate.y;
-        for(int j=i+1; j<n; ++j){
-            x2=atoms[lines[2*j]].coordinate.x;
-            y2=atoms[lines[2*j]].coordinate.y;
-            x3=atoms[lines[2*j+1]].coordinate.x;
-            y3=atoms[lines[2*j+1]].coordinate.y;
-            if(properIntersectionLines(x0,y0,x1,y1,x2,y2,x3,y3)){
-                unitOverlap=true;
-                break;
-            }
-        }
-    }
+    unitOverlap=findEdgeIntersections(listAll);
 }
 
 bool NetworkCart2D::checkGrowth() {
@@ -1190,13 +994,12 @@ bool NetworkCart2D::checkGrowth() {
 }
 
 bool NetworkCart2D::checkLocalGrowth(int rId) {
-    //check overlap of triangles local to given ring
-
-    bool overlap=false;
+    //check triangles local to given ring do not overlap any nearby triangle
+    //an edge crossing a local edge has its m atom within unit reach of the crossing, so nearby units found from grid
 
-    //make list of unique local units
+    //make list of unique local units, those of ring and neighbouring rings
     int rIdNb;
-    vector<int> uIds;
+    ArenaVector<int> uIds(arena);
     uIds.clear();
     for(int i=0; i<rings[rId].units.n;++i) uIds.push_back(rings[rId].units.ids[i]);
     for(int i=0; i<rings[rId].rings.n;++i){
@@ -1208,79 +1011,69 @@ bool NetworkCart2D::checkLocalGrowth(int rId) {
     sort(uIds.begin(), uIds.end());
     uIds.erase(unique(uIds.begin(), uIds.end()), uIds.end());
 
-    //make list of all lines that make up triangles
-    int a, b, c;
-    vector<int> lines;
-    lines.clear();
+    //extent of local units, which may have stretched in optimisation
+    ArenaVector<double> extents(uIds.size(),0.0,arena);
     for(int i=0; i<uIds.size(); ++i){
-        a=units[uIds[i]].atomsX.ids[0];
-        b=units[uIds[i]].atomsX.ids[1];
-        c=units[uIds[i]].atomsX.ids[2];
-        lines.push_back(a);
-        lines.push_back(b);
-        lines.push_back(a);
-        lines.push_back(c);
-        lines.push_back(b);
-        lines.push_back(c);
+        extents[i]=unitExtent(uIds[i]);
+        unitReach=max(unitReach,extents[i]);
     }
 
-    //check overlap of all pairs of lines
-    int n=lines.size()/2;
-    double x0,x1,x2,x3,y0,y1,y2,y3;
-    for(int i=0; i<n-1; ++i){
-        x0=atoms[lines[2*i]].coordinate.x;
-        y0=atoms[lines[2*i]].coordinate.y;
-        x1=atoms[lines[2*i+1]].coordinate.x;
-        y1=atoms[lines[2*i+1]].coordinate.y;
-        for(int j=i+1; j<n; ++j){
-            x2=atoms[lines[2*j]].coordinate.x;
-            y2=atoms[lines[2*j]].coordinate.y;
-            x3=atoms[lines[2*j+1]].coordinate.x;
-            y3=atoms[lines[2*j+1]].coordinate.y;
-            if(properIntersectionLines(x0,y0,x1,y1,x2,y2,x3,y3)){
-                overlap=true;
-                break;
+    //check edges of each local unit against batch of edges of units nearby, pairs of local units checked once
+    int edges[6]={0,1,0,2,1,2}; //pairs of x atoms forming triangle edges
+    for(int i=0; i<uIds.size(); ++i){
+        Unit &unit=units[uIds[i]];
+        grid.radius(atomCrds,&atomCrds[2*unit.atomM],extents[i]+unitReach,nearbyAtoms);
+        segments.clear();
+        for(int j=0; j<nearbyAtoms.size(); ++j){
+            int uIdNb=atomUnit[nearbyAtoms[j]];
+            if(uIdNb<0 || uIdNb==uIds[i]) continue;
+            if(uIdNb<uIds[i] && binary_search(uIds.begin(),uIds.end(),uIdNb)) continue;
+            for(int k=0; k<3; ++k){
+                int c=units[uIdNb].atomsX.ids[edges[2*k]], d=units[uIdNb].atomsX.ids[edges[2*k+1]];
+                Cart2D crdC=getCrd(c), crdD=getCrd(d);
+                segments.add(crdC.x,crdC.y,crdD.x,crdD.y,3*uIdNb+k);
+            }
+        }
+        for(int k=0; k<3; ++k){
+            int a=unit.atomsX.ids[edges[2*k]], b=unit.atomsX.ids[edges[2*k+1]];
+            Cart2D crdA=getCrd(a), crdB=getCrd(b);
+            if(properIntersectionsBatch(crdA.x,crdA.y,crdB.x,crdB.y,segments,0,segments.n,segmentHits)==0) continue;
+            for(int l=0; l<segments.n; ++l){
+                if(!segmentHits[l]) continue;
+                int uIdNb=segments.tags[l]/3, edge=segments.tags[l]%3;
+                int c=units[uIdNb].atomsX.ids[edges[2*edge]], d=units[uIdNb].atomsX.ids[edges[2*edge+1]];
+                if(a!=c && a!=d && b!=c && b!=d) return false;
             }
         }
     }
 
-    return !overlap;
+    return true;
 }
 
-void NetworkCart2D::calculatePercolation(string shape) {
+void NetworkCart2D::calculatePercolation(const Shape &shape) {
     //calculate cluster sizes of rings and percolation
 
-    if(shape=="S"){
-        //if square percolation is defined as a cluster reaching all 4 edges
+    int nSides=shape.nSides();
+    if(nSides>0){
+        //percolation is defined as a cluster reaching all sides of the shape
 
         vector< col_vector<int> > ringClusters; //connected rings of given sizes
 
-        //calculate sample size limits
-        double top=0,bottom=0,left=0,right=0;
+        //calculate sample size as smallest shape enclosing boundary
+        double size=0.0, g;
         for(int i=0; i<boundaryUnits.size(); ++i){
-            Cart2D crd=atoms[units[boundaryUnits[i]].atomM].coordinate;
-            if(crd.x<left) left=crd.x;
-            if(crd.x>right) right=crd.x;
-            if(crd.y<bottom) bottom=crd.y;
-            if(crd.y>top) top=crd.y;
+            Cart2D crd=getCrd(topology.unitAtomM[boundaryUnits[i]]);
+            g=shape.gauge(crd.x,crd.y);
+            if(g<numeric_limits<double>::infinity()) size=max(size,g);
         }
 
-        //loop over boundary units and assign boundary rings
+        //loop over boundary units and assign boundary rings to nearest side
         vector<int> boundaryRings(nRings,-1);
-        double dt,db,dl,dr;
         int edge;
         for(int i=0; i<boundaryUnits.size(); ++i){
-            Cart2D crd=atoms[units[boundaryUnits[i]].atomM].coordinate;
-            dt=fabs(crd.y-top);
-            db=fabs(crd.y-bottom);
-            dl=fabs(crd.x-left);
-            dr=fabs(crd.x-right);
-            if(dt<=db && dt<=dl && dt<=dr) edge=0;
-            else if(db<=dt && db<=dl && db<=dr) edge=1;
-            else if(dl<=dt && dl<=db && dl<=dr) edge=2;
-            else if(dr<=dt && dr<=db && dr<=dl) edge=3;
-            else cout<<"ERROR IN PERCOLATION"<<endl;
-            for(int j=0; j<units[boundaryUnits[i]].rings.n; ++j) boundaryRings[units[boundaryUnits[i]].rings.ids[j]]=edge;
+            Cart2D crd=getCrd(topology.unitAtomM[boundaryUnits[i]]);
+            edge=shape.side(crd.x,crd.y,size);
+            for(int j=0; j<topology.unitRings.size(boundaryUnits[i]); ++j) boundaryRings[topology.unitRings(boundaryUnits[i],j)]=edge;
         }
 
         //update ring colours
@@ -1296,7 +1089,7 @@ void NetworkCart2D::calculatePercolation(string shape) {
                 cluster.clear();
                 cluster.push_back(i);
                 checkRing[i]=false;
-                int ringSize=rings[i].units.n;
+                int ringSize=topology.ringUnits.size(i);
                 clusterTypes.push_back(ringSize);
                 bool searchComplete=false;
                 vector<int> prevSearch,search;
@@ -1307,9 +1100,9 @@ void NetworkCart2D::calculatePercolation(string shape) {
                     search.clear();
                     for(int j=0; j<prevSearch.size();++j){
                         n0=prevSearch[j];
-                        for(int k=0;k<rings[n0].rings.n; ++k){
-                            n1=rings[n0].rings.ids[k];
-                            if(checkRing[n1] && rings[n1].units.n==ringSize){
+                        for(int k=0;k<topology.ringRings.size(n0); ++k){
+                            n1=topology.ringRings(n0,k);
+                            if(checkRing[n1] && topology.ringUnits.size(n1)==ringSize){
                                 search.push_back(n1);
                                 checkRing[n1]=false;
                             }
@@ -1354,16 +1147,16 @@ void NetworkCart2D::calculatePercolation(string shape) {
                 bool spanningCluster=false;
                 for(int j=0; j<indRingClusters.size(); ++j){//check for spanning cluster
                     int clstId=indRingClusters[j];
-                    bool edgeT=false, edgeB=false, edgeL=false, edgeR=false; //flags to check cluster extent to edge
-                    int boundaryCode;
+                    vector<bool> sidesReached(nSides,false); //flags to check cluster extent to each side
+                    int boundaryCode, nReached=0;
                     for(int k=0; k<ringClusters[clstId].n; ++k){
                         boundaryCode=boundaryRings[ringClusters[clstId].values[k]];
-                        if(boundaryCode==0) edgeT=true;
-                        if(boundaryCode==1) edgeB=true;
-                        if(boundaryCode==2) edgeL=true;
-                        if(boundaryCode==3) edgeR=true;
+                        if(boundaryCode>=0 && !sidesReached[boundaryCode]){
+                            sidesReached[boundaryCode]=true;
+                            ++nReached;
+                        }
                     }
-                    if(edgeT && edgeB && edgeL && edgeR){
+                    if(nReached==nSides){
                         spanningCluster=true;
                         break;
                     }
@@ -6,94 +6,23 @@ NetworkCart3DS::NetworkCart3DS() {
 }
 
 NetworkCart3DS::NetworkCart3DS(string prefix, Logfile &logfile, double additionalParams):Network<Cart3D>() {
-    //load network from files, except coordinate data
+    //load network from binary or text files
 
-    //set up file names
-    string atomFilename=prefix+"_atoms.out";
-    string unitFilename=prefix+"_units.out";
-    string ringFilename=prefix+"_rings.out";
-    string cnxFilename=prefix+"_connections.out";
-
-    //check files data
+    //load from binary container if present, otherwise from text files
     logfile.log("Loading network","","",0,false);
-    ifstream atomFile(atomFilename, ios::in);
-    ifstream unitFile(unitFilename, ios::in);
-    ifstream ringFile(ringFilename, ios::in);
-    ifstream cnxFile(cnxFilename, ios::in);
-    if(!atomFile.good()) logfile.errorlog("Cannot find atom input file","critical");
-    if(!unitFile.good()) logfile.errorlog("Cannot find unit input file","critical");
-    if(!ringFile.good()) logfile.errorlog("Cannot find ring input file","critical");
-    if(!cnxFile.good()) logfile.errorlog("Cannot find connection input file","critical");
-
-    //read data
-    vector< vector<int> > dataI;
-    vector< vector<double> > dataD;
-
-    //set up all atoms
-    readFileAll(atomFile,dataD);
-    for(int i=0; i<dataD.size();++i){
-        int elem=int(dataD[i][0]);
-        int cnd=int(dataD[i][1]);
-        Cart3D crd = Cart3D(dataD[i][2], dataD[i][3], additionalParams); //set z coordinate as initial sphere radius
-        Atom<Cart3D> atom(i,elem,cnd);
-        atom.setCoordinate(crd);
-        addAtom(atom);
-    }
-
-    //inital set up of units
-    readFileAll(unitFile,dataI);
-    for(int i=0; i<dataI.size();++i){//set up
-        Unit triangle(i,3,3,3);
-        addUnit(triangle);
-    }
-    for(int i=0; i<dataI.size();++i){//add m atom and unit-atom connections
-        int m=dataI[i][0];
-        units[i].setAtomM(m);
-        for(int j=0; j<3; ++j){
-            addUnitAtomXCnx(i,dataI[i][j+1]);
-        }
-    }
-
-    //initial set up of rings
-    readFileAll(ringFile,dataI);
-    for(int i=0; i<dataI.size();++i){//set up
-        Ring ring(i,dataI[i].size(),dataI[i].size());
-        addRing(ring);
-    }
-    for(int i=0; i<dataI.size();++i){//add unit-ring connections
-        for(int j=0; j<dataI[i].size(); ++j){
-            addUnitRingCnx(dataI[i][j],i);
-        }
-    }
-
-    //add unit-unit connections
-    int n;
-    vector<int> pair;
-    readFileValue(cnxFile,n);
-    for(int i=0; i<n; ++i){
-        readFileRowVector(cnxFile,pair,2);
-        addUnitUnitCnx(pair[0],pair[1]);
-    }
-    //add ring-ring connections
-    readFileValue(cnxFile,n);
-    for(int i=0; i<n; ++i){
-        readFileRowVector(cnxFile,pair,2);
-        addRingRingCnx(pair[0],pair[1]);
+    string binFilename=prefix+networkBinarySuffix;
+    if(binaryFileHasMagic(binFilename,networkMagic)){
+        if(!readBinary(binFilename,additionalParams)) logfile.errorlog("Cannot read binary network file","critical");
+        logfile.log("Network read from: ", binFilename, "", 1, false);
     }
+    else readText(prefix,additionalParams,logfile);
 
     //calculate boundary
     calculateBoundary();
 
-    //close files
-    atomFile.close();
-    unitFile.close();
-    ringFile.close();
-    cnxFile.close();
+    //set up spatial grid
+    initialiseGrid();
 
-    logfile.log("Atoms read from: ", atomFilename, "", 1, false);
-    logfile.log("Units read from: ", unitFilename, "", 1, false);
-    logfile.log("Rings read from: ", ringFilename, "", 1, false);
-    logfile.log("Additional connections read from: ", cnxFilename, "", 1, false);
     logfile.log("Load complete","","",0,true);
 }
 
@@ -110,41 +39,41 @@ void NetworkCart3DS::writeNetwork(string prefix, Logfile &logfile) {
 
     //write out all atom, unit, ring and connection data
     logfile.log("Writing network","","",0,false);
-    ofstream atomFile(atomFilename, ios::in|ios::trunc);
-    ofstream unitFile(unitFilename, ios::in|ios::trunc);
-    ofstream ringFile(ringFilename, ios::in|ios::trunc);
-    ofstream cnxFile(cnxFilename, ios::in|ios::trunc);
-    ofstream visFile(visFilename, ios::in|ios::trunc);
+    TextWriter atomFile(atomFilename);
+    TextWriter unitFile(unitFilename);
+    TextWriter ringFile(ringFilename);
+    TextWriter cnxFile(cnxFilename);
+    TextWriter visFile(visFilename);
 
     //write atom element, coordination and x,y,z coordinate
-    atomFile << fixed << showpoint << setprecision(6);
+    atomFile.setFixed(6);
     for(int i=0; i<nAtoms; ++i){
-        atomFile<<atoms[i].element<<"  "<<atoms[i].coordination<<"  "<<atoms[i].coordinate.x<<"  "<<atoms[i].coordinate.y<<" "<<atoms[i].coordinate.z<<endl;
+        atomFile.put(atoms[i].element).put("  ").put(atoms[i].coordination).put("  ").put(getCrd(i).x).put("  ").put(getCrd(i).y).put(" ").put(getCrd(i).z).endLine();
     }
     logfile.log("Atoms written to: ", atomFilename, "", 1, false);
 
     //write unit atom ids
     for(int i=0; i<nUnits; ++i){
-        writeFileValue(unitFile,units[i].atomM,false);
-        writeFileArray(unitFile,units[i].atomsX.ids,3,true);
+        writeFileValue(unitFile,topology.unitAtomM[i],false);
+        writeFileArray(unitFile,topology.unitAtomsX.begin(i),3,true);
     }
     logfile.log("Units written to: ", unitFilename, "", 1, false);
 
     //write ring unit geometrical unit ids
     for(int i=0; i<nRings; ++i){
-        writeFileArray(ringFile,rings[i].units.ids,rings[i].units.n,true);
+        writeFileArray(ringFile,topology.ringUnits.begin(i),topology.ringUnits.size(i),true);
     }
     logfile.log("Rings written to: ", ringFilename, "", 1, false);
 
-    //write additional connections
+    //write additional connections, ids match indices after cleaning
     int p0, p1;
     vector<int> pair(2);
     vector< vector<int> > unitUnitCnxs;
     unitUnitCnxs.clear();
     for(int i=0; i<nUnits; ++i){
-        p0=units[i].id;
-        for(int j=0; j<units[i].units.n; ++j){
-            p1=units[units[i].units.ids[j]].id;
+        p0=i;
+        for(int j=0; j<topology.unitUnits.size(i); ++j){
+            p1=topology.unitUnits(i,j);
             if(p0<p1){
                 pair[0]=p0;
                 pair[1]=p1;
@@ -157,9 +86,9 @@ void NetworkCart3DS::writeNetwork(string prefix, Logfile &logfile) {
     vector< vector<int> > ringRingCnxs;
     ringRingCnxs.clear();
     for(int i=0; i<nRings; ++i){
-        p0=rings[i].id;
-        for(int j=0; j<rings[i].rings.n; ++j){
-            p1=rings[rings[i].rings.ids[j]].id;
+        p0=i;
+        for(int j=0; j<topology.ringRings.size(i); ++j){
+            p1=topology.ringRings(i,j);
             if(p0<p1){
                 pair[0]=p0;
                 pair[1]=p1;
@@ -177,12 +106,12 @@ void NetworkCart3DS::writeNetwork(string prefix, Logfile &logfile) {
     logfile.log("Visualisation helper file written to: ", visFilename, "", 1, false);
 
     //write x,y,z file
-    ofstream xyzFile(xyzFilename, ios::in|ios::trunc);
-    atomFile << fixed << showpoint << setprecision(6);
+    TextWriter xyzFile(xyzFilename);
+    xyzFile.setGeneral(6);
     writeFileValue(xyzFile,nAtoms,true);
     writeFileValue(xyzFile," ",true);
     for(int i=0; i<nAtoms; ++i){
-        xyzFile<<atoms[i].element<<"  "<<atoms[i].coordinate.x<<"  "<<atoms[i].coordinate.y<<" "<<atoms[i].coordinate.z<<endl;
+        xyzFile.put(atoms[i].element).put("  ").put(getCrd(i).x).put("  ").put(getCrd(i).y).put(" ").put(getCrd(i).z).endLine();
     }
     logfile.log("xyz file written to: ", xyzFilename, "", 1, false);
 
@@ -200,79 +129,35 @@ void NetworkCart3DS::writeNetworkSpecial(string prefix, Logfile &logfile) {
     return;
 }
 
-vector<double> NetworkCart3DS::getCrds() {
-    //get all atom coordinates collapsed onto 1d
-    vector<double> crds;
-    crds.clear();
-    for(int i=0; i<nAtoms; ++i){
-        crds.push_back(atoms[i].coordinate.x);
-        crds.push_back(atoms[i].coordinate.y);
-        crds.push_back(atoms[i].coordinate.z);
-    }
-    return crds;
-}
-
-vector<double> NetworkCart3DS::getCrds(map<int, int> &globalAtomMap, int n) {
-    //get local atom coordinates collapsed onto 1d
-    vector<double> crds;
-    crds.clear();
-    int id;
-    for(int i=0; i<n; ++i){
-        id=globalAtomMap.at(i);
-        crds.push_back(atoms[id].coordinate.x);
-        crds.push_back(atoms[id].coordinate.y);
-        crds.push_back(atoms[id].coordinate.z);
-    }
-    return crds;
-}
-
-void NetworkCart3DS::setCrds(vector<double> &crds) {
-    //set all atom coordinates
-    for(int i=0; i<nAtoms; ++i){
-        atoms[i].coordinate.x=crds[3*i];
-        atoms[i].coordinate.y=crds[3*i+1];
-        atoms[i].coordinate.z=crds[3*i+2];
-    }
-}
-
-void NetworkCart3DS::setCrds(map<int, int> &globalAtomMap, vector<double> &crds) {
-    //set local atom coordinates
-    int n=crds.size()/3;
-    int id;
-    for(int i=0; i<n; ++i){
-        id=globalAtomMap.at(i);
-        atoms[id].coordinate.x=crds[3*i];
-        atoms[id].coordinate.y=crds[3*i+1];
-        atoms[id].coordinate.z=crds[3*i+2];
-    }
-}
-
-void NetworkCart3DS::setGO(int it, double ls, double conv, int loc) {
+void NetworkCart3DS::setGO(int it, double ls, double conv, int loc, int threads) {
     //set up optimiser with geometry optimisation parameters
     localExtent=loc;
+    globalThreads=threads;
     defLineInc=ls;
-    optimiser=SteepestDescentArmijo<HLJC3S>(it,ls,conv);
+    optimiser=SteepestDescentArmijo< HLJC3S<double> >(it,ls,conv);
+    optimiserSP=SteepestDescentArmijo< HLJC3S<float> >(it,ls,conv);
 }
 
 void NetworkCart3DS::geometryOptimiseGlobal(vector<double> &potentialModel) {
     //set up harmonic potential before passing to derived class
 
     //reset potential information
-    vector<int> bonds, angles, repulsions, fixedAtoms, interx, constrainedAtoms;
-    vector<double>  bondK, bondR0, repK, repR0, conK, conR0, crds;
+    ArenaVector<int> bonds, angles, repulsions, fixedAtoms, interx, constrainedAtoms;
+    ArenaVector<int> bondTypes; //type code for each bond, M-X 0 and X-X 1
+    ArenaVector<double> bondK, bondR0; //parameters for each bond type
     bonds.clear();
     angles.clear();
     repulsions.clear();
     fixedAtoms.clear();
     interx.clear();
     constrainedAtoms.clear();
+    bondTypes.clear();
     bondK.clear();
     bondR0.clear();
-    repK.clear();
-    repR0.clear();
-
-    //get all atom coordinates
-    crds=getCrds();
+    bondK.push_back(potentialModel[0]);
+    bondR0.push_back(potentialModel[1]);
+    bondK.push_back(potentialModel[2]);
+    bondR0.push_back(potentialModel[3]);
 
     //loop over triangle units to get M-X, X-X bonds
     int mId0, xId0, xId1, xId2;
@@ -284,182 +169,176 @@ void NetworkCart3DS::geometryOptimiseGlobal(vector<double> &potentialModel) {
         //M-X
         bonds.push_back(mId0);
         bonds.push_back(xId0);
-        bondK.push_back(potentialModel[0]);
-        bondR0.push_back(potentialModel[1]);
+        bondTypes.push_back(0);
         bonds.push_back(mId0);
         bonds.push_back(xId1);
-        bondK.push_back(potentialModel[0]);
-        bondR0.push_back(potentialModel[1]);
+        bondTypes.push_back(0);
         bonds.push_back(mId0);
         bonds.push_back(xId2);
-        bondK.push_back(potentialModel[0]);
-        bondR0.push_back(potentialModel[1]);
+        bondTypes.push_back(0);
         //X-X
         bonds.push_back(xId0);
         bonds.push_back(xId1);
-        bondK.push_back(potentialModel[2]);
-        bondR0.push_back(potentialModel[3]);
+        bondTypes.push_back(1);
         bonds.push_back(xId0);
         bonds.push_back(xId2);
-        bondK.push_back(potentialModel[2]);
-        bondR0.push_back(potentialModel[3]);
+        bondTypes.push_back(1);
         bonds.push_back(xId1);
         bonds.push_back(xId2);
-        bondK.push_back(potentialModel[2]);
-        bondR0.push_back(potentialModel[3]);
+        bondTypes.push_back(1);
     }
 
-    //loop over all m atoms and add M-M LJ interactions
-    int mId1;
-    for(int i=0; i<nUnits-1;++i){
-        mId0=units[i].atomM;
-        for(int j=i+1; j<nUnits; ++j){
-            mId1=units[j].atomM;
-            repulsions.push_back(mId0);
-            repulsions.push_back(mId1);
-            repK.push_back(potentialModel[6]);
-            repR0.push_back(potentialModel[7]);
-        }
-    }
 
     //add spherical constraints
     for(int i=0; i<nAtoms; ++i){
         constrainedAtoms.push_back(i);
-        conK.push_back(potentialModel[8]);
-        conR0.push_back(potentialModel[9]);
     }
 
-    //set up model and optimise
-    HLJC3S potential(bonds,angles,repulsions,fixedAtoms,interx,constrainedAtoms,bondK,bondR0,repK,repR0,conK,conR0);
+    //set up model and optimise, with M-M LJ interactions only between m atoms within cutoff plus skin
+    //list regenerated from grid whenever any atom moves over half the skin, so no interacting pair is missed
+    double cutoff=repulsionCutoff(potentialModel[7]);
+    double range=cutoff*(1.0+neighbourSkin);
+    grid.build(atomCrds);
+    findRepulsions(atomCrds.data(),range,repulsions);
+    HLJC3S<double> potential(bonds,angles,repulsions,fixedAtoms,interx,bondTypes,bondK,bondR0,potentialModel[6],potentialModel[7],
+                             constrainedAtoms,SphereConstraint<3,double>(potentialModel[8],potentialModel[9]));
+    if(!repTable.empty()) potential.setRepulsionTable(&repTable);
+    potential.setThreads(globalThreads);
+    col_vector<double> crds(atomCrds.data(),atomCrds.size()); //view of coordinate buffer, optimised in place
+    potential.setNeighbourUpdate([this,range](col_vector<double> &c, ArenaVector<int> &rep){
+        grid.build(c.values,c.n/Cart3D::dim);
+        findRepulsions(c.values,range,rep);
+    },0.5*(range-cutoff),crds);
     optimiser(potential, energy, optIterations, crds);
-
-    //update coordinates
-    setCrds(crds);
+    grid.build(atomCrds);
+    measureUnitReach();
 }
 
-void NetworkCart3DS::geometryOptimiseLocal(vector<double> &potentialModel) {
+void NetworkCart3DS::geometryOptimiseLocal(vector<double> &potentialModel, bool singlePrecision) {
     //geometry optimise atoms only in local region
 
     //reset potential information
-    vector<int> bonds, angles, repulsions, fixedAtoms, interx, constrainedAtoms;
-    vector<double>  bondK, bondR0, repK, repR0, conK, conR0, crds;
+    ArenaVector<int> bonds(arena), angles(arena), repulsions(arena), fixedAtoms(arena), interx(arena), constrainedAtoms(arena);
+    ArenaVector<int> bondTypes(arena); //type code for each bond, M-X 0 and X-X 1
+    ArenaVector<double> bondK(arena), bondR0(arena); //parameters for each bond type
     bonds.clear();
     angles.clear();
     repulsions.clear();
     fixedAtoms.clear();
     interx.clear();
     constrainedAtoms.clear();
+    bondTypes.clear();
     bondK.clear();
     bondR0.clear();
-    repK.clear();
-    repR0.clear();
+    bondK.push_back(potentialModel[0]);
+    bondR0.push_back(potentialModel[1]);
+    bondK.push_back(potentialModel[2]);
+    bondR0.push_back(potentialModel[3]);
 
     //get local region
     findLocalRegion(rings.rbegin()[0].id,localExtent);
 
-    //get local atom coordinates
-    crds=getCrds(globalAtomMap,nLocalAtoms);
-
     //loop over triangle units to get M-X, X-X bonds
     int mId0, xId0, xId1, xId2;
     for(int i=0; i<flexLocalUnits.size(); ++i){
-        mId0=localAtomMap.at(units[flexLocalUnits[i]].atomM);
-        xId0=localAtomMap.at(units[flexLocalUnits[i]].atomsX.ids[0]);
-        xId1=localAtomMap.at(units[flexLocalUnits[i]].atomsX.ids[1]);
-        xId2=localAtomMap.at(units[flexLocalUnits[i]].atomsX.ids[2]);
+        mId0=localAtomMap[units[flexLocalUnits[i]].atomM];
+        xId0=localAtomMap[units[flexLocalUnits[i]].atomsX.ids[0]];
+        xId1=localAtomMap[units[flexLocalUnits[i]].atomsX.ids[1]];
+        xId2=localAtomMap[units[flexLocalUnits[i]].atomsX.ids[2]];
         //M-X
         bonds.push_back(mId0);
         bonds.push_back(xId0);
-        bondK.push_back(potentialModel[0]);
-        bondR0.push_back(potentialModel[1]);
+        bondTypes.push_back(0);
         bonds.push_back(mId0);
         bonds.push_back(xId1);
-        bondK.push_back(potentialModel[0]);
-        bondR0.push_back(potentialModel[1]);
+        bondTypes.push_back(0);
         bonds.push_back(mId0);
         bonds.push_back(xId2);
-        bondK.push_back(potentialModel[0]);
-        bondR0.push_back(potentialModel[1]);
+        bondTypes.push_back(0);
         //X-X
         bonds.push_back(xId0);
         bonds.push_back(xId1);
-        bondK.push_back(potentialModel[2]);
-        bondR0.push_back(potentialModel[3]);
+        bondTypes.push_back(1);
         bonds.push_back(xId0);
         bonds.push_back(xId2);
-        bondK.push_back(potentialModel[2]);
-        bondR0.push_back(potentialModel[3]);
+        bondTypes.push_back(1);
         bonds.push_back(xId1);
         bonds.push_back(xId2);
-        bondK.push_back(potentialModel[2]);
-        bondR0.push_back(potentialModel[3]);
+        bondTypes.push_back(1);
     }
     for(int i=0; i<fixedLocalUnits.size(); ++i){
-        mId0=localAtomMap.at(units[fixedLocalUnits[i]].atomM);
-        xId0=localAtomMap.at(units[fixedLocalUnits[i]].atomsX.ids[0]);
-        xId1=localAtomMap.at(units[fixedLocalUnits[i]].atomsX.ids[1]);
-        xId2=localAtomMap.at(units[fixedLocalUnits[i]].atomsX.ids[2]);
+        mId0=localAtomMap[units[fixedLocalUnits[i]].atomM];
+        xId0=localAtomMap[units[fixedLocalUnits[i]].atomsX.ids[0]];
+        xId1=localAtomMap[units[fixedLocalUnits[i]].atomsX.ids[1]];
+        xId2=localAtomMap[units[fixedLocalUnits[i]].atomsX.ids[2]];
         //M-X
         bonds.push_back(mId0);
         bonds.push_back(xId0);
-        bondK.push_back(potentialModel[0]);
-        bondR0.push_back(potentialModel[1]);
+        bondTypes.push_back(0);
         bonds.push_back(mId0);
         bonds.push_back(xId1);
-        bondK.push_back(potentialModel[0]);
-        bondR0.push_back(potentialModel[1]);
+        bondTypes.push_back(0);
         bonds.push_back(mId0);
         bonds.push_back(xId2);
-        bondK.push_back(potentialModel[0]);
-        bondR0.push_back(potentialModel[1]);
+        bondTypes.push_back(0);
         //X-X
         bonds.push_back(xId0);
         bonds.push_back(xId1);
-        bondK.push_back(potentialModel[2]);
-        bondR0.push_back(potentialModel[3]);
+        bondTypes.push_back(1);
         bonds.push_back(xId0);
         bonds.push_back(xId2);
-        bondK.push_back(potentialModel[2]);
-        bondR0.push_back(potentialModel[3]);
+        bondTypes.push_back(1);
         bonds.push_back(xId1);
         bonds.push_back(xId2);
-        bondK.push_back(potentialModel[2]);
-        bondR0.push_back(potentialModel[3]);
+        bondTypes.push_back(1);
     }
 
     //loop over m atoms and add M-M LJ interactions
     int mId1;
     for(int i=0; i<flexLocalUnits.size()-1;++i){
-        mId0=localAtomMap.at(units[flexLocalUnits[i]].atomM);
+        mId0=localAtomMap[units[flexLocalUnits[i]].atomM];
         for(int j=i+1; j<flexLocalUnits.size(); ++j){
-            mId1=localAtomMap.at(units[flexLocalUnits[j]].atomM);
+            mId1=localAtomMap[units[flexLocalUnits[j]].atomM];
             repulsions.push_back(mId0);
             repulsions.push_back(mId1);
-            repK.push_back(potentialModel[6]);
-            repR0.push_back(potentialModel[7]);
         }
         for(int j=0; j<fixedLocalUnits.size(); ++j){
-            mId1=localAtomMap.at(units[fixedLocalUnits[j]].atomM);
+            mId1=localAtomMap[units[fixedLocalUnits[j]].atomM];
             repulsions.push_back(mId0);
             repulsions.push_back(mId1);
-            repK.push_back(potentialModel[6]);
-            repR0.push_back(potentialModel[7]);
         }
     }
 
     //add spherical constraints
     for(int i=0; i<nLocalAtoms; ++i){
         constrainedAtoms.push_back(i);
-        conK.push_back(potentialModel[8]);
-        conR0.push_back(potentialModel[9]);
     }
 
-    //set up model and optimise
-    HLJC3S potential(bonds,angles,repulsions,fixedAtoms,interx,constrainedAtoms,bondK,bondR0,repK,repR0,conK,conR0);
-    optimiser(potential, energy, optIterations, crds);
-
-    //update coordinates
-    setCrds(globalAtomMap,crds);
+    //add soft penalty between nearby edges of local units, if requested
+    if(potentialModel[10]>0.0) findLocalInterx(interx);
+
+    //set up model and optimise local coordinates, in single precision if requested
+    if(singlePrecision){
+        HLJC3S<float> potential(bonds,angles,repulsions,fixedAtoms,interx,bondTypes,bondK,bondR0,potentialModel[6],potentialModel[7],
+                                constrainedAtoms,SphereConstraint<3,float>(potentialModel[8],potentialModel[9]));
+        if(!repTableSP.empty()) potential.setRepulsionTable(&repTableSP);
+        potential.setIntersectionPenalty(potentialModel[10]);
+        col_vector<float> crds(arena.allocate<float>(3*nLocalAtoms),3*nLocalAtoms);
+        getCrds(globalAtomMap,crds);
+        optimiserSP(potential, energy, optIterations, crds);
+        setCrds(globalAtomMap,crds);
+    }
+    else{
+        HLJC3S<double> potential(bonds,angles,repulsions,fixedAtoms,interx,bondTypes,bondK,bondR0,potentialModel[6],potentialModel[7],
+                                 constrainedAtoms,SphereConstraint<3,double>(potentialModel[8],potentialModel[9]));
+        if(!repTable.empty()) potential.setRepulsionTable(&repTable);
+        potential.setIntersectionPenalty(potentialModel[10]);
+        col_vector<double> crds(arena.allocate<double>(3*nLocalAtoms),3*nLocalAtoms);
+        getCrds(globalAtomMap,crds);
+        optimiser(potential, energy, optIterations, crds);
+        setCrds(globalAtomMap,crds);
+    }
+    raiseLocalUnitReach();
 }
 
 bool NetworkCart3DS::checkGrowth() {
@@ -470,41 +349,83 @@ bool NetworkCart3DS::checkGrowth() {
     bool flag=false;
     for(int i=0; i<boundaryUnits.size(); ++i){
         mId=units[boundaryUnits[i]].atomM;
-        z=atoms[mId].coordinate.z;
+        z=getCrd(mId).z;
         if(z<0.0) flag=true;
     }
     return flag;
 }
 
 bool NetworkCart3DS::checkLocalGrowth(int rId) {
-    //placeholder
+    //check triangles local to given ring do not overlap any nearby triangle, edges taken as great circle arcs
+    //an arc crossing a local arc has its m atom within unit reach of the crossing, so nearby units found from grid
+    //grid cells only stored where atoms lie, so buckets follow the sphere surface
+
+    //make list of unique local units, those of ring and neighbouring rings
+    int rIdNb;
+    ArenaVector<int> uIds(arena);
+    uIds.clear();
+    for(int i=0; i<rings[rId].units.n;++i) uIds.push_back(rings[rId].units.ids[i]);
+    for(int i=0; i<rings[rId].rings.n;++i){
+        rIdNb=rings[rId].rings.ids[i];
+        for(int j=0; j<rings[rIdNb].units.n; ++j){
+            uIds.push_back(rings[rIdNb].units.ids[j]);
+        }
+    }
+    sort(uIds.begin(), uIds.end());
+    uIds.erase(unique(uIds.begin(), uIds.end()), uIds.end());
+
+    //extent of local units, which may have stretched in optimisation
+    ArenaVector<double> extents(uIds.size(),0.0,arena);
+    for(int i=0; i<uIds.size(); ++i){
+        extents[i]=unitExtent(uIds[i]);
+        unitReach=max(unitReach,extents[i]);
+    }
+
+    //check arcs of each local unit against arcs of units nearby, pairs of local units checked once
+    //search radius widened as arcs bow out from chords between atoms
+    int edges[6]={0,1,0,2,1,2}; //pairs of x atoms forming triangle edges
+    for(int i=0; i<uIds.size(); ++i){
+        Unit &unit=units[uIds[i]];
+        grid.radius(atomCrds,&atomCrds[3*unit.atomM],1.1*(extents[i]+unitReach),nearbyAtoms);
+        for(int j=0; j<nearbyAtoms.size(); ++j){
+            int uIdNb=atomUnit[nearbyAtoms[j]];
+            if(uIdNb<0 || uIdNb==uIds[i]) continue;
+            if(uIdNb<uIds[i] && binary_search(uIds.begin(),uIds.end(),uIdNb)) continue;
+            Unit &unitNb=units[uIdNb];
+            for(int k=0; k<3; ++k){
+                int a=unit.atomsX.ids[edges[2*k]], b=unit.atomsX.ids[edges[2*k+1]];
+                for(int l=0; l<3; ++l){
+                    int c=unitNb.atomsX.ids[edges[2*l]], d=unitNb.atomsX.ids[edges[2*l+1]];
+                    if(a==c || a==d || b==c || b==d) continue;
+                    if(properIntersectionArcs(getCrd(a),getCrd(b),getCrd(c),getCrd(d))) return false;
+                }
+            }
+        }
+    }
+
     return true;
 }
 
-int NetworkCart3DS::getActiveUnit(string shape, double size){
-//    find active unit within given shape, return -1 if cannot find
+int NetworkCart3DS::getActiveUnit(const Shape &shape, double size){
+//    find active unit within given shape projected onto x-y plane, return -1 if cannot find
 
     int unitId=-1;
     int atomId; //id of atom with dangling bond
-
-    if(shape=="S") {//projected onto circle in x-y plane
-        Cart2D projection;
-        double rsq = size * size;
-        for (int i = 0; i < boundaryUnits.size(); ++i) {
-            atomId = boundaryStatus[i];
-            if (atomId >= 0) {
-                projection=atoms[atomId].coordinate.xyProjection();
-                if (projection.normSq() < rsq) {
-                    unitId = boundaryUnits[i];
-                    break;
-                }
+    Cart2D projection;
+    for (int i = 0; i < boundaryUnits.size(); ++i) {
+        atomId = boundaryStatus[i];
+        if (atomId >= 0) {
+            projection=getCrd(atomId).xyProjection();
+            if (shape.contains(projection.x,projection.y,size)) {
+                unitId = boundaryUnits[i];
+                break;
             }
         }
     }
     return unitId;
 }
 
-void NetworkCart3DS::buildRing0(vector<int> &unitPath) {
+void NetworkCart3DS::buildRing0(const ArenaVector<int> &unitPath) {
     //build ring of same size as unit path - change X atom of one unit
 
     //get ids of dangling atoms in path
@@ -527,7 +448,7 @@ void NetworkCart3DS::buildRing0(vector<int> &unitPath) {
     //assign ring-units
     for(int i=0; i<unitPath.size(); ++i) addUnitRingCnx(unitPath.rbegin()[i],ringId);
     //assign ring-rings
-    vector<int> nbRings;
+    ArenaVector<int> nbRings(arena);
     nbRings.clear();
     for(int i=0; i<unitPath.size(); ++i){
         for(int j=0; j<units[unitPath[i]].rings.n;++j){
@@ -546,7 +467,7 @@ void NetworkCart3DS::buildRing0(vector<int> &unitPath) {
     return;
 }
 
-void NetworkCart3DS::buildRing(int ringSize, vector<int> &unitPath, vector<double> &potentialModel){
+void NetworkCart3DS::buildRing(int ringSize, const ArenaVector<int> &unitPath, vector<double> &potentialModel){
     //build a ring of a given size to a starting path
 
     //calculate number of new species
@@ -558,7 +479,7 @@ void NetworkCart3DS::buildRing(int ringSize, vector<int> &unitPath, vector<doubl
 
     //set up ids for new species
     int ringId=nRings;
-    vector<int> mAtomIds(nNewM), x3AtomIds(nNewX3), x4AtomIds(nNewX4), triIds(nNewTriangles);
+    ArenaVector<int> mAtomIds(nNewM,0,arena), x3AtomIds(nNewX3,0,arena), x4AtomIds(nNewX4,0,arena), triIds(nNewTriangles,0,arena);
     for(int i=0; i<nNewTriangles; ++i) triIds[i]=nUnits+i;
     for(int i=0; i<nNewM; ++i) mAtomIds[i]=nAtoms+i;
     for(int i=0; i<nNewX3; ++i) x3AtomIds[i]=mAtomIds.rbegin()[0]+i+1;
@@ -585,12 +506,12 @@ void NetworkCart3DS::buildRing(int ringSize, vector<int> &unitPath, vector<doubl
 
     //make new triangles
     for(int i=0; i<nNewTriangles; ++i){
-        Unit triangle(nUnits,3,3,3);
+        Unit triangle(nUnits);
         addUnit(triangle);
     }
     //assign m atoms and x3 atoms
     for(int i=0; i<nNewTriangles; ++i){
-        units[triIds[i]].setAtomM(mAtomIds[i]);
+        setUnitAtomM(triIds[i],mAtomIds[i]);
         addUnitAtomXCnx(triIds[i],x3AtomIds[i]);
     }
     //assign x4 atoms
@@ -612,7 +533,7 @@ void NetworkCart3DS::buildRing(int ringSize, vector<int> &unitPath, vector<doubl
     for(int i=0; i<unitPath.size(); ++i) addUnitRingCnx(unitPath.rbegin()[i],ringId);
     for(int i=0; i<nNewTriangles; ++i) addUnitRingCnx(triIds[i],ringId);
     //assign ring-rings
-    vector<int> nbRings;
+    ArenaVector<int> nbRings(arena);
     nbRings.clear();
     for(int i=0; i<unitPath.size(); ++i){
         for(int j=0; j<units[unitPath[i]].rings.n;++j){
@@ -632,11 +553,11 @@ void NetworkCart3DS::buildRing(int ringSize, vector<int> &unitPath, vector<doubl
     //generate new coordinates by projecting onto x-y plane, then offsetting in z-direction
     //generate vectors
     Cart2D uvPar, uvPer; //unit vectors parallel and perpendicular to L->R
-    uvPar=(atoms[atomIdR].coordinate-atoms[atomIdL].coordinate).xyProjection();
+    uvPar=(getCrd(atomIdR)-getCrd(atomIdL)).xyProjection();
     Cart2D vClockwise(uvPar.y,-uvPar.x);
     Cart2D vAntiClockwise(-uvPar.y,uvPar.x);
-//    Cart2D dir=atoms[atomIdL].coordinate-atoms[units[unitPath[0]].atomM].coordinate;
-    Cart2D dir=((atoms[atomIdL].coordinate+atoms[atomIdR].coordinate)*0.5).xyProjection();
+//    Cart2D dir=getCrd(atomIdL)-getCrd(units[unitPath[0]].atomM);
+    Cart2D dir=((getCrd(atomIdL)+getCrd(atomIdR))*0.5-(getCrd(units[unitPath[0]].atomM)+getCrd(units[unitPath.rbegin()[0]].atomM))*0.5).xyProjection();
     if(vClockwise*dir>0) uvPer=vClockwise;
     else uvPer=vAntiClockwise;
     double perLen, parLen; //lengths of original perpendicular and parallel vectors
@@ -650,60 +571,60 @@ void NetworkCart3DS::buildRing(int ringSize, vector<int> &unitPath, vector<doubl
         vy=Cart3D(uvPer*potentialModel[3],-potentialModel[3]);
         //X4
         int index=0;
-        Cart3D crd=atoms[atomIdL].coordinate;
+        Cart3D crd=getCrd(atomIdL);
         for(int i=0; i<(nNewX4-1)/2; ++i){
             crd+=vy;
-            atoms[x4AtomIds[index]].coordinate=crd;
+            setCrd(x4AtomIds[index],crd);
             ++index;
         }
         crd+=vx*0.5+vy;
-        atoms[x4AtomIds[index]].coordinate=crd;
+        setCrd(x4AtomIds[index],crd);
         ++index;
         crd+=vx*0.5-vy;
         for(int i=0; i<nNewX4/2; ++i){
-            atoms[x4AtomIds[index]].coordinate=crd;
+            setCrd(x4AtomIds[index],crd);
             ++index;
             crd-=vy;
         }
         //M
         index=0;
         vx=uvPar*(parLen+potentialModel[1]);
-        crd=atoms[atomIdL].coordinate-uvPar*potentialModel[1]*0.5+vy*0.5;
+        crd=getCrd(atomIdL)-uvPar*potentialModel[1]*0.5+vy*0.5;
         for(int i=0; i<nNewM/2-1; ++i){
-            atoms[mAtomIds[index]].coordinate=crd;
+            setCrd(mAtomIds[index],crd);
             ++index;
             crd+=vy;
         }
         crd+=vy;
         for(int i=0; i<2; ++i){
             crd+=vx/3.0;
-            atoms[mAtomIds[index]].coordinate=crd;
+            setCrd(mAtomIds[index],crd);
             ++index;
         }
         crd+=vx/3.0-vy*2.0;
         for(int i=0; i<nNewM/2-1; ++i){
-            atoms[mAtomIds[index]].coordinate=crd;
+            setCrd(mAtomIds[index],crd);
             ++index;
             crd-=vy;
         }
         //X3
         index=0;
         vx=uvPar*(parLen+potentialModel[1]*3.0);
-        crd=atoms[atomIdL].coordinate-uvPar*potentialModel[1]*1.5+vy*0.5;
+        crd=getCrd(atomIdL)-uvPar*potentialModel[1]*1.5+vy*0.5;
         for(int i=0; i<nNewX3/2-1; ++i){
-            atoms[x3AtomIds[index]].coordinate=crd;
+            setCrd(x3AtomIds[index],crd);
             ++index;
             crd+=vy;
         }
         crd+=vy*2.0;
         for(int i=0; i<2; ++i){
             crd+=vx/3.0;
-            atoms[x3AtomIds[index]].coordinate=crd;
+            setCrd(x3AtomIds[index],crd);
             ++index;
         }
         crd+=vx/3.0-vy*3.0;
         for(int i=0; i<nNewX3/2-1; ++i){
-            atoms[x3AtomIds[index]].coordinate=crd;
+            setCrd(x3AtomIds[index],crd);
             ++index;
             crd-=vy;
         }
@@ -715,51 +636,51 @@ void NetworkCart3DS::buildRing(int ringSize, vector<int> &unitPath, vector<doubl
         vx=uvPar*parLen;
         vy=Cart3D(uvPer*potentialModel[3],-potentialModel[3]);
         //X4
-        Cart3D crd=atoms[atomIdL].coordinate;
+        Cart3D crd=getCrd(atomIdL);
         for(int i=0; i<nNewX4/2; ++i){
             crd+=vy;
-            atoms[x4AtomIds[index]].coordinate=crd;
+            setCrd(x4AtomIds[index],crd);
             ++index;
         }
         crd+=vx;
         for(int i=0; i<nNewX4/2; ++i){
-            atoms[x4AtomIds[index]].coordinate=crd;
+            setCrd(x4AtomIds[index],crd);
             ++index;
             crd-=vy;
         }
         //M
         index=0;
         vx=uvPar*(parLen+potentialModel[1]);
-        crd=atoms[atomIdL].coordinate-uvPar*potentialModel[1]*0.5+vy*0.5;
+        crd=getCrd(atomIdL)-uvPar*potentialModel[1]*0.5+vy*0.5;
         for(int i=0; i<(nNewM-1)/2; ++i){
-            atoms[mAtomIds[index]].coordinate=crd;
+            setCrd(mAtomIds[index],crd);
             ++index;
             crd+=vy;
         }
         crd+=vx*0.5;
-        atoms[mAtomIds[index]].coordinate=crd;
+        setCrd(mAtomIds[index],crd);
         ++index;
         crd+=vx*0.5-vy;
         for(int i=0; i<(nNewM-1)/2; ++i){
-            atoms[mAtomIds[index]].coordinate=crd;
+            setCrd(mAtomIds[index],crd);
             ++index;
             crd-=vy;
         }
         //X3
         index=0;
         vx=uvPar*(parLen+potentialModel[1]*3.0);
-        crd=atoms[atomIdL].coordinate-uvPar*potentialModel[1]*1.5+vy*0.5;
+        crd=getCrd(atomIdL)-uvPar*potentialModel[1]*1.5+vy*0.5;
         for(int i=0; i<(nNewX3-1)/2; ++i){
-            atoms[x3AtomIds[index]].coordinate=crd;
+            setCrd(x3AtomIds[index],crd);
             ++index;
             crd+=vy;
         }
         crd+=vx*0.5+vy;
-        atoms[x3AtomIds[index]].coordinate=crd;
+        setCrd(x3AtomIds[index],crd);
         ++index;
         crd+=vx*0.5-vy*2.0;
         for(int i=0; i<(nNewM-1)/2; ++i){
-            atoms[x3AtomIds[index]].coordinate=crd;
+            setCrd(x3AtomIds[index],crd);
             ++index;
             crd-=vy;
         }
@@ -767,7 +688,7 @@ void NetworkCart3DS::buildRing(int ringSize, vector<int> &unitPath, vector<doubl
     return;
 }
 
-void NetworkCart3DS::popRing0(vector<int> &unitPath) {
+void NetworkCart3DS::popRing0(const ArenaVector<int> &unitPath) {
     //remove last built ring (of same size as unit path)
 
     //get ids of x-atoms to dis/reconnect
@@ -790,7 +711,7 @@ void NetworkCart3DS::popRing0(vector<int> &unitPath) {
     for(int i=0; i<unitPath.size(); ++i) delUnitRingCnx(unitPath[i],nRings);
 
     //remove ring-ring connections
-    vector<int> nbRings;
+    ArenaVector<int> nbRings(arena);
     nbRings.clear();
     for(int i=0; i<unitPath.size(); ++i){
         for(int j=0; j<units[unitPath[i]].rings.n;++j){
@@ -808,7 +729,7 @@ void NetworkCart3DS::popRing0(vector<int> &unitPath) {
     }
 }
 
-void NetworkCart3DS::popRing(int ringSize, vector<int> &unitPath){
+void NetworkCart3DS::popRing(int ringSize, const ArenaVector<int> &unitPath){
      //remove last built ring
 
     //calculate number of species
@@ -836,7 +757,7 @@ void NetworkCart3DS::popRing(int ringSize, vector<int> &unitPath){
     for(int i=0; i<unitPath.size(); ++i) delUnitRingCnx(unitPath[i],nRings);
 
     //remove ring-ring connections
-    vector<int> nbRings;
+    ArenaVector<int> nbRings(arena);
     nbRings.clear();
     for(int i=0; i<unitPath.size(); ++i){
         for(int j=0; j<units[unitPath[i]].rings.n;++j){
@@ -855,50 +776,12 @@ void NetworkCart3DS::popRing(int ringSize, vector<int> &unitPath){
     return;
 }
 
-void NetworkCart3DS::checkOverlap(){
-     //check for overlap of any triangles by projecting onto x-y plane
-
-    unitOverlap=false;
-
-    //make list of all lines that make up triangles
-    int a, b, c;
-    vector<int> lines;
-    lines.clear();
-    for(int i=0; i<nUnits; ++i){
-        a=units[i].atomsX.ids[0];
-        b=units[i].atomsX.ids[1];
-        c=units[i].atomsX.ids[2];
-        lines.push_back(a);
-        lines.push_back(b);
-        lines.push_back(a);
-        lines.push_back(c);
-        lines.push_back(b);
-        lines.push_back(c);
-    }
-
-    //check overlap of all pairs of lines
-    int n=lines.size()/2;
-    double x0,x1,x2,x3,y0,y1,y2,y3;
-    for(int i=0; i<n-1; ++i){
-        x0=atoms[lines[2*i]].coordinate.x;
-        y0=atoms[lines[2*i]].coordinate.y;
-        x1=atoms[lines[2*i+1]].coordinate.x;
-        y1=atoms[lines[2*i+1]].coordinate.y;
-        for(int j=i+1; j<n; ++j){
-            x2=atoms[lines[2*j]].coordinate.x;
-            y2=atoms[lines[2*j]].coordinate.y;
-            x3=atoms[lines[2*j+1]].coordinate.x;
-            y3=atoms[lines[2*j+1]].coordinate.y;
-            if(properIntersectionLines(x0,y0,x1,y1,x2,y2,x3,y3)){
-                unitOverlap=true;
-                break;
-            }
-        }
-    }
-    return;
+void NetworkCart3DS::checkOverlap(bool listAll){
+    //check for overlap of any triangles by projecting onto x-y plane
+    unitOverlap=findEdgeIntersections(listAll);
 }
 
-void NetworkCart3DS::calculatePercolation(string shape) {
+void NetworkCart3DS::calculatePercolation(const Shape &shape) {
     //calculate cluster sizes and if percolation occurs
     return;
 }
\ No newline at end of file
@@ -16,13 +16,10 @@ class NetworkCart3DS:public Network<Cart3D> {
 
 protected:
     //Geometry Optimisation
-    SteepestDescentArmijo<HLJC3S> optimiser;
+    SteepestDescentArmijo< HLJC3S<double> > optimiser;
+    SteepestDescentArmijo< HLJC3S<float> > optimiserSP; //single precision, for trial rings
 
     //Virtual Methods To Define
-    vector<double> getCrds() override; //get all atom coordinates
-    vector<double> getCrds(map<int,int> &globalAtomMap, int n); //get local atom coordinates
-    void setCrds(vector<double> &crds) override; //set all atom coordinates
-    void setCrds(map<int,int> &globalAtomMap, vector<double> &crds); //set all atom coordinates
 
 public:
     //Constructors
@@ -30,21 +27,21 @@ public:
     NetworkCart3DS(string prefix, Logfile &logfile, double additionalParams=0.0); //load network from files
 
     //Virtual Methods To Define
-    void setGO(int it, double ls, double conv, int loc) override; //set up optimiser
+    void setGO(int it, double ls, double conv, int loc, int threads) override; //set up optimiser
     void geometryOptimiseGlobal(vector<double> &potentialModel) override; //optimise geometry with steepest descent
-    void geometryOptimiseLocal(vector<double> &potentialModel) override; //optimise geometry with steepest descent
+    void geometryOptimiseLocal(vector<double> &potentialModel, bool singlePrecision=false) override; //optimise geometry with steepest descent
     void writeNetwork(string prefix, Logfile &logfile) override; //write network to files
     void writeNetworkSpecial(string prefix, Logfile &logfile) override; //write network in different format
 
-    int getActiveUnit(string shape, double size) override; //find active unit within shape
-    void buildRing(int ringSize, vector<int> &unitPath, vector<double> &potentialModel) override; //build a ring of given size
-    void buildRing0(vector<int> &unitPath) override; //build a ring of same size as unit path
-    void popRing(int ringSize, vector<int> &unitPath) override; //remove last built ring
-    void popRing0(vector<int> &unitPath) override; //remove last built ring of same size as unit path
-    void checkOverlap() override; //check for overlap
+    int getActiveUnit(const Shape &shape, double size) override; //find active unit within shape
+    void buildRing(int ringSize, const ArenaVector<int> &unitPath, vector<double> &potentialModel) override; //build a ring of given size
+    void buildRing0(const ArenaVector<int> &unitPath) override; //build a ring of same size as unit path
+    void popRing(int ringSize, const ArenaVector<int> &unitPath) override; //remove last built ring
+    void popRing0(const ArenaVector<int> &unitPath) override; //remove last built ring of same size as unit path
+    void checkOverlap(bool listAll) override; //check for overlap
     bool checkGrowth() override; //check to continue growth
     bool checkLocalGrowth(int rId) override; //check if acceptable local growth
-    void calculatePercolation(string shape) override; //clusters and percolation
+    void calculatePercolation(const Shape &shape) override; //clusters and percolation
 };
 
 
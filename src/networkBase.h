@@ -6,15 +6,32 @@
 #include <algorithm>
 #include <string>
 #include <map>
+#include <limits>
+#include <cmath>
 #include "easyIO.h"
 #include "logfile.h"
 #include "atom.h"
 #include "unit.h"
 #include "ring.h"
 #include "analysis_tools.h"
+#include "pairTable.h"
+#include "topology.h"
+#include "hilbert.h"
+#include "spatialGrid.h"
+#include "arena.h"
+#include "intersections.h"
+#include "shapes.h"
+#include "binaryIO.h"
+#include "textIO.h"
+#include "trajectory.h"
 
 using namespace std;
 
+const double neighbourSkin=0.5; //extra range of repulsion neighbour lists, as fraction of cutoff
+const char networkMagic[]="MX2N"; //first bytes of binary network container
+const uint32_t networkVersion=1; //version of binary network layout
+const string networkBinarySuffix="_network.bin"; //binary network file name after prefix
+
 template <typename CrdT>
 class Network {
     //base class for network containing all atom, unit and ring information
@@ -23,8 +40,17 @@ protected:
     //Key Variables
     int nAtoms, nUnits, nRings; //number of atoms, units and rings
     vector< Atom<CrdT> > atoms; //atoms in network (both m and x)
+    vector<double> atomCrds; //coordinates of atoms, contiguous with CrdT::dim values per atom
+    SpatialGrid<CrdT> grid; //spatial grid over atoms, kept in sync with coordinates
+    vector<int> atomUnit; //unit of each m atom, -1 for x atoms
+    double unitReach; //bound on distance from m atom to its x atoms, so units near a point can be found from grid
+    vector<int> nearbyAtoms, nearbyUnits; //scratch for grid queries
+    SegmentBlock segments; //scratch for batched intersection tests
+    vector<unsigned char> segmentHits; //results of batched intersection tests
     vector<Unit> units; //triangles in network
     vector<Ring> rings; //rings in network
+    Topology topology; //flat snapshot of unit and ring connectivity, valid after clean
+    Arena arena; //scratch memory for temporaries of current growth step
 
     //Additional Variables
     //Structural
@@ -35,10 +61,18 @@ protected:
     double defLineInc; //default line search increment
     double energy; //potential energy
     int localExtent, nLocalAtoms; //size of local region, number of atoms in local region
-    map<int,int> localAtomMap, globalAtomMap; //maps local to global atoms
+    int globalThreads; //number of threads for global optimisation
+    PairTable<double> repTable; //tabulated repulsion, empty if analytic
+    PairTable<float> repTableSP; //tabulated repulsion for single precision optimisation
+    vector<int> localAtomMap, globalAtomMap; //global to local atom ids (valid where stamped), local to global atom ids
+    vector<int> unitStamps, atomStamps; //generation in which unit/atom last added to local region
+    int regionStamp; //current local region generation
     vector<int> flexLocalUnits, fixedLocalUnits, fixedLocalAtoms; //units that make up local region, and fixed atoms
+    //Write Out
+    int networkFormat; //network files written, 0 text, 1 binary, 2 both
     //Analysis
     bool unitOverlap, writeFullDistributions; //check for overlap of units, calculate full bond len/angle distributions
+    vector<int> overlapUnits; //pairs of units with intersecting edges, first pair only unless all listed
     DiscreteDistribution ringStatistics, bulkRingStatistics; //ring size distribution for entire network, and excluding edges
     map<int,DiscreteDistribution> indRingStatistics; //ring size distributions around each individual ring
     vector<double> aboavWeaireParameters; //alpha, mu and rsq
@@ -49,29 +83,52 @@ protected:
     vector< col_vector<int> > ringColours; //for visualisation
 
     //Methods
-    virtual vector<double> getCrds()=0; //get all atom coordinates - virtual as have different number of variables and will be faster
-    virtual void setCrds(vector<double> &crds)=0; //set all atom coordinates - virtual as have different number of variables and will be faster
+    CrdT getCrd(int aId); //get coordinate of atom
+    void setCrd(int aId, CrdT crd); //set coordinate of atom
+    vector<double> getCrds(); //get all atom coordinates
+    void setCrds(vector<double> &crds); //set all atom coordinates
+    template <typename T> void getCrds(vector<int> &globalAtomMap, col_vector<T> &crds); //gather local atom coordinates
+    template <typename T> void setCrds(vector<int> &globalAtomMap, col_vector<T> &crds); //scatter local atom coordinates
     bool checkActiveUnit(int &uId, int sumCheck=12); //checks if active by summing associated atom coordination
     bool checkEdgeUnit(int &uId, int ringCheck=3); //checks if edge by number of associated rings
     void calculateBoundary(); //work out boundary units
-    virtual int getActiveUnit(string shape, double size)=0; //find active unit within shape
+    virtual int getActiveUnit(const Shape &shape, double size)=0; //find active unit within shape
     void findLocalRegion(int &rId, int nFlexShells); //find local units around given ring
+    void addLocalUnitAtoms(int uId, bool fixed); //add atoms of unit to local region
+    void initialiseGrid(); //set grid cell size from bond lengths and build
+    double unitExtent(int uId); //distance from m atom to furthest x atom of unit
+    void measureUnitReach(); //set unit reach from all units
+    void raiseLocalUnitReach(); //raise unit reach over flexible units of local region
+    void indexUnits(); //rebuild map from m atoms to units
+    void setUnitAtomM(int uId, int aId); //set m atom of unit and map back
+    double repulsionCutoff(double r0); //range of repulsion, analytic or tabulated
+    void findRepulsions(const double *crds, double range, ArenaVector<int> &repulsions); //pairs of m atoms within range, in unit order
+    void findLocalInterx(ArenaVector<int> &interx); //pairs of nearby edges in local region for intersection penalty
+    bool findEdgeIntersections(bool listAll); //proper intersections of unit edges in x-y plane
+    void readText(string prefix, double additionalParams, Logfile &logfile); //load network from text files
+    bool readBinary(string filename, double additionalParams); //load network from binary container
+    void writeBinary(string prefix, Logfile &logfile); //write network to binary container
+    void writeFormats(string prefix, Logfile &logfile); //write network in requested formats
 
 public:
     //Constructors
     Network();
 
     //Setters
-    virtual void setGO(int it, double ls, double conv, int loc)=0; //virtual as set up optimiser with different potential types
+    virtual void setGO(int it, double ls, double conv, int loc, int threads)=0; //virtual as set up optimiser with different potential types
+    void setRepulsionTable(PairTable<double> &table); //use tabulated repulsion in optimisation
+    void setNetworkFormat(int format); //choose text, binary or both for network files
 
     //Getters
     int getNRings();
     double getEnergy();
     int getIterations();
+    Arena& getArena();
+    vector<int> getOverlapUnits();
 
     //Methods
     //Build Network
-    void addAtom(Atom<CrdT> atom);
+    void addAtom(const Atom<CrdT> &atom, CrdT crd=CrdT());
     void addUnit(Unit unit);
     void addRing(Ring ring);
     void delAtom();
@@ -85,34 +142,41 @@ public:
     void delUnitRingCnx(int uId, int rId);
     void delRingRingCnx(int rId1, int rId2);
     void changeUnitAtomXCnx(int uId, int aId1, int aId2);
-    bool trialRing(int ringSize, vector<int> &unitPath, vector<double> &potentialModel); //test a trial ring of given size
-    void acceptRing(int ringSize, vector<int> &unitPath, vector<double> &potentialModel); //accept a ring of given size
-    void clean(); //clean network of dead atoms
-    virtual void buildRing(int ringSize, vector<int> &unitPath, vector<double> &potentialModel)=0; //build a ring of given size
-    virtual void buildRing0(vector<int> &unitPath)=0; //build a ring of same size as unit path
-    virtual void popRing(int ringSize, vector<int> &unitPath)=0; //remove last built ring
-    virtual void popRing0(vector<int> &unitPath)=0; //remove last built ring of same size as unit path
+    bool trialRing(int ringSize, const ArenaVector<int> &unitPath, vector<double> &potentialModel, bool singlePrecision=false, bool restore=false); //test a trial ring of given size, optionally leaving coordinates unchanged
+    void acceptRing(int ringSize, const ArenaVector<int> &unitPath, vector<double> &potentialModel); //accept a ring of given size
+    vector<int> compact(); //remove dead atoms and remap atom ids, new id of each atom or -1, empty if none removed
+    void clean(); //clean network of dead atoms and take topology snapshot
+    void reorder(); //sort atoms, units and rings along hilbert curve and remap ids
+    void resetArena(); //reclaim scratch memory at start of growth step
+    virtual void buildRing(int ringSize, const ArenaVector<int> &unitPath, vector<double> &potentialModel)=0; //build a ring of given size
+    virtual void buildRing0(const ArenaVector<int> &unitPath)=0; //build a ring of same size as unit path
+    virtual void popRing(int ringSize, const ArenaVector<int> &unitPath)=0; //remove last built ring
+    virtual void popRing0(const ArenaVector<int> &unitPath)=0; //remove last built ring of same size as unit path
     virtual bool checkGrowth()=0; //check to continue growth
     virtual bool checkLocalGrowth(int rId)=0; //check if acceptable local growth
 
     //Search Network
-    vector<int> getBoundarySection(int startId, bool direction); //find section of unit boundary in given direction
+    ArenaVector<int> getBoundarySection(int startId, bool direction); //find section of unit boundary in given direction
     //Optimise Network
     virtual void geometryOptimiseGlobal(vector<double> &potentialModel)=0;
-    virtual void geometryOptimiseLocal(vector<double> &potentialModel)=0;
+    virtual void geometryOptimiseLocal(vector<double> &potentialModel, bool singlePrecision=false)=0;
     //Analyse Network
     void calculateRingStatistics(); //ring stats analysis
     void calculateBondDistributions(bool fullDist); //bond len/angle distributions
     void calculateRingAreas(); //area of rings analysis
-    virtual void checkOverlap()=0; //check for overlap
-    virtual void calculatePercolation(string shape)=0; //clusters and percolation
+    virtual void checkOverlap(bool listAll)=0; //check for overlap, optionally finding all overlapping units
+    virtual void calculatePercolation(const Shape &shape)=0; //clusters and percolation
 
     //Write Out
+    void getFrame(TrajectoryFrame &frame); //copy atoms and rings new since frame's first ids, all coordinates and units
     void write(string prefix, bool special, Logfile &logfile); //write out to files
     virtual void writeNetwork(string prefix, Logfile &logfile)=0; //write network to files
     virtual void writeNetworkSpecial(string prefix, Logfile &logfile)=0; //write network in different format
     void writeAnalysis(string prefix, Logfile &logfile); //write analysis out to files
     void kill(string prefix, Logfile &logfile); //prepare network for early termination and write out
+
+    //Monitoring
+    void logMemory(Logfile &logfile, int indent, bool breakdown); //log bytes held by network containers
 };
 
 #include "networkBase.tpp"
@@ -11,12 +11,28 @@ Network<CrdT>::Network() {
     nRings=0;
     energy=numeric_limits<double>::infinity();
     optIterations=-1;
+    regionStamp=0;
+    unitReach=0.0;
+    networkFormat=0;
     atoms.clear();
     units.clear();
     rings.clear();
     boundaryUnits.clear();
 }
 
+template <typename CrdT>
+void Network<CrdT>::setRepulsionTable(PairTable<double> &table) {
+    //set tabulated repulsion, in both precisions
+    repTable=table;
+    repTableSP=PairTable<float>(table);
+}
+
+template <typename CrdT>
+void Network<CrdT>::setNetworkFormat(int format) {
+    //network files written as 0 text, 1 binary, 2 both
+    networkFormat=format;
+}
+
 template <typename CrdT>
 int Network<CrdT>::getNRings() {
     //return number of rings in network
@@ -36,23 +52,101 @@ int Network<CrdT>::getIterations() {
 }
 
 template <typename CrdT>
-void Network<CrdT>::addAtom(Atom<CrdT> atom) {
-    //add atom to network and update map
+vector<int> Network<CrdT>::getOverlapUnits() {
+    return overlapUnits;
+}
+
+template <typename CrdT>
+Arena& Network<CrdT>::getArena() {
+    //return scratch memory for current growth step
+    return arena;
+}
+
+//##### COORDINATES #####
+template <typename CrdT>
+inline CrdT Network<CrdT>::getCrd(int aId) {
+    //get coordinate of atom from buffer
+    CrdT crd;
+    crd.load(&atomCrds[CrdT::dim*aId]);
+    return crd;
+}
+
+template <typename CrdT>
+inline void Network<CrdT>::setCrd(int aId, CrdT crd) {
+    //set coordinate of atom in buffer
+    crd.store(&atomCrds[CrdT::dim*aId]);
+    grid.update(aId,&atomCrds[CrdT::dim*aId]);
+}
+
+template <typename CrdT>
+vector<double> Network<CrdT>::getCrds() {
+    //get all atom coordinates
+    return atomCrds;
+}
+
+template <typename CrdT>
+void Network<CrdT>::setCrds(vector<double> &crds) {
+    //set all atom coordinates, moving only changed atoms in grid
+    const int d=CrdT::dim;
+    for(int i=0; i<nAtoms; ++i){
+        bool changed=false;
+        for(int j=0; j<d; ++j){
+            if(atomCrds[d*i+j]!=crds[d*i+j]){
+                atomCrds[d*i+j]=crds[d*i+j];
+                changed=true;
+            }
+        }
+        if(changed) grid.update(i,&atomCrds[d*i]);
+    }
+}
+
+template <typename CrdT>
+template <typename T>
+void Network<CrdT>::getCrds(vector<int> &globalAtomMap, col_vector<T> &crds) {
+    //gather local atom coordinates into contiguous buffer, sized for local atoms
+    const int d=CrdT::dim;
+    int n=crds.n/d;
+    for(int i=0; i<n; ++i){
+        const double *c=&atomCrds[d*globalAtomMap[i]];
+        for(int j=0; j<d; ++j) crds[d*i+j]=c[j];
+    }
+}
+
+template <typename CrdT>
+template <typename T>
+void Network<CrdT>::setCrds(vector<int> &globalAtomMap, col_vector<T> &crds) {
+    //scatter local atom coordinates back into buffer
+    const int d=CrdT::dim;
+    int n=crds.n/d;
+    for(int i=0; i<n; ++i){
+        double *c=&atomCrds[d*globalAtomMap[i]];
+        for(int j=0; j<d; ++j) c[j]=crds[d*i+j];
+        grid.update(globalAtomMap[i],c);
+    }
+}
+
+template <typename CrdT>
+void Network<CrdT>::addAtom(const Atom<CrdT> &atom, CrdT crd) {
+    //add atom to network with coordinate
     atoms.push_back(atom);
+    atomCrds.resize(atomCrds.size()+CrdT::dim);
+    crd.store(&atomCrds[CrdT::dim*nAtoms]);
+    grid.insert(nAtoms,&atomCrds[CrdT::dim*nAtoms]);
+    atomUnit.push_back(-1);
     ++nAtoms;
 }
 
 template <typename CrdT>
 void Network<CrdT>::addUnit(Unit unit) {
-    //add unit to network and update map
-    units.push_back(unit);
+    //add unit to network and update map, taking ownership of connections
+    units.push_back(move(unit));
     ++nUnits;
 }
 
 template <typename CrdT>
 void Network<CrdT>::addRing(Ring ring) {
-    //add ring to network and update map
-    rings.push_back(ring);
+    //add ring to network and update map, taking ownership of connections
+    rings.push_back(move(ring));
     ++nRings;
 }
 
@@ -60,12 +154,17 @@ template <typename CrdT>
 void Network<CrdT>::delAtom() {
     //delete atom from network
     atoms.pop_back();
+    atomCrds.resize(atomCrds.size()-CrdT::dim);
+    grid.remove(nAtoms-1);
+    atomUnit.pop_back();
     --nAtoms;
 }
 
 template <typename CrdT>
 void Network<CrdT>::delUnit() {
-    //delete unit from network
+    //delete unit from network, m atom may already be deleted
+    int m=units.back().atomM;
+    if(m>=0 && m<atomUnit.size()) atomUnit[m]=-1;
     units.pop_back();
     --nUnits;
 }
@@ -152,7 +251,7 @@ bool Network<CrdT>::checkEdgeUnit(int &uId, int ringCheck) {
 }
 
 template <typename CrdT>
-bool Network<CrdT>::trialRing(int ringSize, vector<int> &unitPath, vector<double> &potentialModel) {
+bool Network<CrdT>::trialRing(int ringSize, const ArenaVector<int> &unitPath, vector<double> &potentialModel, bool singlePrecision, bool restore) {
     //build a ring of a given size to a starting path
     //minimise and calculate energy
     //remove ring
@@ -162,12 +261,16 @@ bool Network<CrdT>::trialRing(int ringSize, vector<int> &unitPath, vector<double
     if(ringSize==unitPath.size()) ring0=true;
     else ring0=false;
 
+    //store coordinates if trial should not affect network
+    vector<double> crds0;
+    if(restore) crds0=getCrds();
+
     //build trial ring
     if(ring0) buildRing0(unitPath);
     else buildRing(ringSize, unitPath, potentialModel);
 
     //geometry optimise
-    geometryOptimiseLocal(potentialModel);
+    geometryOptimiseLocal(potentialModel,singlePrecision);
 //    geometryOptimiseGlobal(potentialModel);
 
     //check for geometry anomalies
@@ -176,12 +279,13 @@ bool Network<CrdT>::trialRing(int ringSize, vector<int> &unitPath, vector<double
     //pop trial ring
     if(ring0) popRing0(unitPath);
     else popRing(ringSize, unitPath);
+    if(restore) setCrds(crds0);
 
     return geometryCheck;
 }
 
 template <typename CrdT>
-void Network<CrdT>::acceptRing(int ringSize, vector<int> &unitPath, vector<double> &potentialModel) {
+void Network<CrdT>::acceptRing(int ringSize, const ArenaVector<int> &unitPath, vector<double> &potentialModel) {
     //build ring of given size to a starting path, minimise and calculate boundary
 
     if(ringSize==unitPath.size()) buildRing0(unitPath);
@@ -192,28 +296,29 @@ void Network<CrdT>::acceptRing(int ringSize, vector<int> &unitPath, vector<doubl
 }
 
 template <typename CrdT>
-void Network<CrdT>::clean() {
-    //remove any uncoordinated atoms and reassign ids
+vector<int> Network<CrdT>::compact() {
+    //remove any uncoordinated atoms and reassign ids, in single stable pass
+    //zero-coordinate atoms are artefacts of build process from buildRing0
 
-    //loop over atoms and find zero-coordinate species
-    map<int,int> updatedAtomIds; //reassigned ids
-    vector<int> removeAtoms; //atoms with zero coordination - artefacts of build process from buildRing0
-    removeAtoms.clear();
+    //shift surviving atoms down, recording new id of each atom (-1 if removed)
+    vector<int> updatedAtomIds(nAtoms);
     int aId=0;
     for(int i=0; i<nAtoms; ++i){
-        if(atoms[i].coordination==0){
-            removeAtoms.push_back(i);
-            updatedAtomIds[i]=-1;
-        }
+        if(atoms[i].coordination==0) updatedAtomIds[i]=-1;
         else{
+            if(aId!=i){
+                atoms[aId]=atoms[i];
+                for(int j=0; j<CrdT::dim; ++j) atomCrds[CrdT::dim*aId+j]=atomCrds[CrdT::dim*i+j];
+            }
             updatedAtomIds[i]=aId;
             ++aId;
         }
     }
-
-    //remove atoms from list in reverse order
-    for(int i=0; i<removeAtoms.size(); ++i) atoms.erase(atoms.begin()+removeAtoms.rbegin()[i]);
-    nAtoms-=removeAtoms.size();
+    if(aId==nAtoms) return vector<int>();
+    atoms.erase(atoms.begin()+aId,atoms.end());
+    atomCrds.resize(CrdT::dim*aId);
+    grid.build(atomCrds);
+    nAtoms=aId;
 
     //update atom ids in unit connections
     int aId0, aId1;
@@ -230,6 +335,119 @@ void Network<CrdT>::clean() {
         if(aId1==-1) cout<<"ERROR IN NETWORK CLEANING"<<endl;
         units[i].atomM=aId1;
     }
+    indexUnits();
+
+    //update active atoms on boundary
+    for(int i=0; i<boundaryStatus.size(); ++i){
+        if(boundaryStatus[i]>=0) boundaryStatus[i]=updatedAtomIds[boundaryStatus[i]];
+    }
+    return updatedAtomIds;
+}
+
+template <typename CrdT>
+void Network<CrdT>::clean() {
+    //remove any uncoordinated atoms and reassign ids, then take snapshot of connectivity for analysis and writing
+    compact();
+    topology.build(units,rings);
+}
+
+template <typename CrdT>
+void Network<CrdT>::resetArena() {
+    //reclaim scratch memory, no containers from previous growth step may still be alive
+    arena.reset();
+}
+
+template <typename CrdT>
+void Network<CrdT>::reorder() {
+    //sort atoms, units and rings along hilbert curve through their positions and remap all ids
+    //species created along growth front drift apart in memory from their neighbours, this restores locality
+    //units ordered by metal atom, rings by centre of metal atoms
+
+    compact();
+    const int d=CrdT::dim;
+
+    //bounding box for quantising coordinates
+    double crdMin[d], crdMax[d], scale[d];
+    for(int j=0; j<d; ++j){
+        crdMin[j]=numeric_limits<double>::infinity();
+        crdMax[j]=-numeric_limits<double>::infinity();
+    }
+    for(int i=0; i<nAtoms; ++i){
+        for(int j=0; j<d; ++j){
+            crdMin[j]=min(crdMin[j],atomCrds[d*i+j]);
+            crdMax[j]=max(crdMax[j],atomCrds[d*i+j]);
+        }
+    }
+    double gridMax=(1u<<hilbertBits)-1;
+    for(int j=0; j<d; ++j) scale[j]=(crdMax[j]>crdMin[j]) ? gridMax/(crdMax[j]-crdMin[j]) : 0.0;
+    auto key=[&](const double *c){
+        array<unsigned int,d> q;
+        for(int j=0; j<d; ++j) q[j]=(c[j]-crdMin[j])*scale[j];
+        return hilbertIndex<d>(q);
+    };
+
+    //keys and new orders
+    vector<unsigned long long> atomKeys(nAtoms), unitKeys(nUnits), ringKeys(nRings);
+    for(int i=0; i<nAtoms; ++i) atomKeys[i]=key(&atomCrds[d*i]);
+    for(int i=0; i<nUnits; ++i) unitKeys[i]=atomKeys[units[i].atomM];
+    double centre[d];
+    for(int i=0; i<nRings; ++i){
+        for(int j=0; j<d; ++j) centre[j]=0.0;
+        for(int k=0; k<rings[i].units.n; ++k){
+            const double *c=&atomCrds[d*units[rings[i].units.ids[k]].atomM];
+            for(int j=0; j<d; ++j) centre[j]+=c[j];
+        }
+        for(int j=0; j<d; ++j) centre[j]/=rings[i].units.n;
+        ringKeys[i]=key(centre);
+    }
+    vector<int> atomOrder=hilbertOrder(atomKeys), unitOrder=hilbertOrder(unitKeys), ringOrder=hilbertOrder(ringKeys);
+    vector<int> newAtomIds(nAtoms), newUnitIds(nUnits), newRingIds(nRings);
+    for(int i=0; i<nAtoms; ++i) newAtomIds[atomOrder[i]]=i;
+    for(int i=0; i<nUnits; ++i) newUnitIds[unitOrder[i]]=i;
+    for(int i=0; i<nRings; ++i) newRingIds[ringOrder[i]]=i;
+
+    //permute atoms and coordinates
+    vector< Atom<CrdT> > sortedAtoms(nAtoms);
+    vector<double> sortedCrds(d*nAtoms);
+    for(int i=0; i<nAtoms; ++i){
+        sortedAtoms[i]=atoms[atomOrder[i]];
+        sortedAtoms[i].id=i;
+        for(int j=0; j<d; ++j) sortedCrds[d*i+j]=atomCrds[d*atomOrder[i]+j];
+    }
+    atoms.swap(sortedAtoms);
+    atomCrds.swap(sortedCrds);
+    grid.build(atomCrds);
+
+    //permute units and remap their connections, order within connectors kept
+    vector<Unit> sortedUnits(nUnits);
+    for(int i=0; i<nUnits; ++i){
+        Unit &unit=sortedUnits[i];
+        unit=move(units[unitOrder[i]]);
+        unit.id=i;
+        unit.atomM=newAtomIds[unit.atomM];
+        for(int j=0; j<unit.atomsX.n; ++j) unit.atomsX.ids[j]=newAtomIds[unit.atomsX.ids[j]];
+        for(int j=0; j<unit.units.n; ++j) unit.units.ids[j]=newUnitIds[unit.units.ids[j]];
+        for(int j=0; j<unit.rings.n; ++j) unit.rings.ids[j]=newRingIds[unit.rings.ids[j]];
+    }
+    units.swap(sortedUnits);
+    indexUnits();
+
+    //permute rings and remap their connections, unit order around ring kept
+    vector<Ring> sortedRings(nRings);
+    for(int i=0; i<nRings; ++i){
+        Ring &ring=sortedRings[i];
+        ring=move(rings[ringOrder[i]]);
+        ring.id=i;
+        for(int j=0; j<ring.units.n; ++j) ring.units.ids[j]=newUnitIds[ring.units.ids[j]];
+        for(int j=0; j<ring.rings.n; ++j) ring.rings.ids[j]=newRingIds[ring.rings.ids[j]];
+    }
+    rings.swap(sortedRings);
+
+    //remap boundary, keeping perimeter order
+    for(int i=0; i<boundaryUnits.size(); ++i){
+        boundaryUnits[i]=newUnitIds[boundaryUnits[i]];
+        if(boundaryStatus[i]>=0) boundaryStatus[i]=newAtomIds[boundaryStatus[i]];
+    }
 }
 
 template <typename CrdT>
@@ -369,14 +587,13 @@ void Network<CrdT>::calculateBoundary() {
 }
 
 template <typename CrdT>
-vector<int> Network<CrdT>::getBoundarySection(int startId, bool direction) {
+ArenaVector<int> Network<CrdT>::getBoundarySection(int startId, bool direction) {
     //find section of unit boundary in given direction
 
     //find position of id in boundary
     int startPos = find(boundaryUnits.begin(), boundaryUnits.end(), startId) - boundaryUnits.begin();
 
-    vector<int> section;
-    section.clear();
+    ArenaVector<int> section(arena);
     section.push_back(startId);
     int n=boundaryUnits.size();
 
@@ -404,95 +621,306 @@ template <typename CrdT>
 void Network<CrdT>::findLocalRegion(int &rId, int nFlexShells) {
     //find units around and included in a given ring, within a given number of connections, make map of corresponding local atoms
     //have flexible shells, then fixed shell
+    //membership of units and atoms in region tested with generation stamps, so nothing cleared between calls
 
-    localAtomMap.clear();
-    globalAtomMap.clear();
     flexLocalUnits.clear();
     fixedLocalUnits.clear();
     fixedLocalAtoms.clear();
+    globalAtomMap.clear();
+
+    //new generation, stale stamps from previous regions no longer match
+    if(unitStamps.size()<units.size()) unitStamps.resize(units.size(),0);
+    if(atomStamps.size()<atoms.size()){
+        atomStamps.resize(atoms.size(),0);
+        localAtomMap.resize(atoms.size(),-1);
+    }
+    if(regionStamp==numeric_limits<int>::max()){
+        fill(unitStamps.begin(),unitStamps.end(),0);
+        fill(atomStamps.begin(),atomStamps.end(),0);
+        regionStamp=0;
+    }
+    ++regionStamp;
 
     //get units in ring
-    vector<int> shell0(rings[rId].units.n), shell1;
-    for(int i=0; i<rings[rId].units.n; ++i) shell0[i]=rings[rId].units.ids[i];
-    for(int i=0; i<shell0.size(); ++i) flexLocalUnits.push_back(shell0[i]);
+    ArenaVector<int> shell0(rings[rId].units.n,0,arena), shell1(arena);
+    for(int i=0; i<rings[rId].units.n; ++i){
+        shell0[i]=rings[rId].units.ids[i];
+        unitStamps[shell0[i]]=regionStamp;
+        flexLocalUnits.push_back(shell0[i]);
+    }
 
     //loop over flexible shells and get units, then get fixed shell
+    int u;
     for(int i=0; i<nFlexShells+1; ++i){
         shell1.clear();
-        //find adjecent units to shell0
+        //find adjacent units to shell0 not already in region
         for(int j=0; j<shell0.size(); ++j){
             for(int k=0; k<units[shell0[j]].units.n; ++k){
-                shell1.push_back(units[shell0[j]].units.ids[k]);
+                u=units[shell0[j]].units.ids[k];
+                if(unitStamps[u]!=regionStamp){
+                    unitStamps[u]=regionStamp;
+                    shell1.push_back(u);
+                }
             }
         }
         if(shell1.size()>0){
-            //get unique units not in shell0
+            //order units in shell by id
             sort(shell1.begin(), shell1.end());
-            shell1.erase(unique(shell1.begin(), shell1.end()),shell1.end());
-            for (int i=0; i <flexLocalUnits.size(); ++i) shell1.erase(remove(shell1.begin(), shell1.end(), flexLocalUnits[i]), shell1.end());
             //add to vector
             if(i!=nFlexShells){
-                for(int i=0; i<shell1.size(); ++i) flexLocalUnits.push_back(shell1[i]);
+                for(int j=0; j<shell1.size(); ++j) flexLocalUnits.push_back(shell1[j]);
             }
             else{
-                for(int i=0; i<shell1.size(); ++i) fixedLocalUnits.push_back(shell1[i]);
+                for(int j=0; j<shell1.size(); ++j) fixedLocalUnits.push_back(shell1[j]);
             }
-            shell0=shell1;
+            shell0.swap(shell1);
         }
         else break;
     }
 
     //make map of atoms to include in local region
-    int m, x;
     nLocalAtoms=0;
-    for(int i=0; i<flexLocalUnits.size(); ++i){
-        m=units[flexLocalUnits[i]].atomM;
-        if(localAtomMap.count(m)==0){
-            localAtomMap[m]=nLocalAtoms;
-            globalAtomMap[nLocalAtoms]=m;
+    for(int i=0; i<flexLocalUnits.size(); ++i) addLocalUnitAtoms(flexLocalUnits[i],false);
+    for(int i=0; i<fixedLocalUnits.size(); ++i) addLocalUnitAtoms(fixedLocalUnits[i],true);
+}
+
+template <typename CrdT>
+void Network<CrdT>::addLocalUnitAtoms(int uId, bool fixed) {
+    //add metal then x atoms of unit to local region if not already present
+    int a;
+    for(int i=-1; i<units[uId].atomsX.n; ++i){
+        a=(i==-1) ? units[uId].atomM : units[uId].atomsX.ids[i];
+        if(atomStamps[a]!=regionStamp){
+            atomStamps[a]=regionStamp;
+            localAtomMap[a]=nLocalAtoms;
+            globalAtomMap.push_back(a);
+            if(fixed) fixedLocalAtoms.push_back(nLocalAtoms);
             ++nLocalAtoms;
         }
-        for(int j=0; j<units[flexLocalUnits[i]].atomsX.n; ++j){
-            x=units[flexLocalUnits[i]].atomsX.ids[j];
-            if(localAtomMap.count(x)==0){
-                localAtomMap[x]=nLocalAtoms;
-                globalAtomMap[nLocalAtoms]=x;
-                ++nLocalAtoms;
-            }
+    }
+}
+
+template <typename CrdT>
+void Network<CrdT>::initialiseGrid() {
+    //set cell size to twice mean M-X bond length, about one M-M separation, then build grid
+    double sumMX=0.0;
+    int nMX=0;
+    for(int i=0; i<nUnits; ++i){
+        CrdT crdM=getCrd(units[i].atomM);
+        for(int j=0; j<units[i].atomsX.n; ++j){
+            CrdT crdMX=crdM-getCrd(units[i].atomsX.ids[j]);
+            sumMX+=crdMX.norm();
+            ++nMX;
         }
     }
-    for(int i=0; i<fixedLocalUnits.size(); ++i){
-        m=units[fixedLocalUnits[i]].atomM;
-        if(localAtomMap.count(m)==0){
-            localAtomMap[m]=nLocalAtoms;
-            globalAtomMap[nLocalAtoms]=m;
-            fixedLocalAtoms.push_back(nLocalAtoms);
-            ++nLocalAtoms;
+    if(nMX>0 && sumMX>0.0) grid.setCellSize(2.0*sumMX/nMX);
+    grid.build(atomCrds);
+    measureUnitReach();
+}
+
+template <typename CrdT>
+double Network<CrdT>::unitExtent(int uId) {
+    //largest m-x distance in unit
+    double extent=0.0;
+    CrdT crdM=getCrd(units[uId].atomM);
+    for(int i=0; i<units[uId].atomsX.n; ++i){
+        CrdT crdMX=crdM-getCrd(units[uId].atomsX.ids[i]);
+        extent=max(extent,crdMX.norm());
+    }
+    return extent;
+}
+
+template <typename CrdT>
+void Network<CrdT>::measureUnitReach() {
+    //largest extent over all units, only grows during local optimisation so raised as units checked
+    unitReach=0.0;
+    for(int i=0; i<nUnits; ++i) unitReach=max(unitReach,unitExtent(i));
+}
+
+template <typename CrdT>
+void Network<CrdT>::raiseLocalUnitReach() {
+    //local optimisation can stretch any flexible unit, so raise reach over them to keep it bounding all units
+    for(int i=0; i<flexLocalUnits.size(); ++i) unitReach=max(unitReach,unitExtent(flexLocalUnits[i]));
+}
+
+template <typename CrdT>
+void Network<CrdT>::indexUnits() {
+    //map each m atom to its unit
+    atomUnit.assign(nAtoms,-1);
+    for(int i=0; i<nUnits; ++i) atomUnit[units[i].atomM]=i;
+}
+
+template <typename CrdT>
+void Network<CrdT>::setUnitAtomM(int uId, int aId) {
+    //set m atom of unit and record unit against atom
+    units[uId].setAtomM(aId);
+    atomUnit[aId]=uId;
+}
+
+template <typename CrdT>
+double Network<CrdT>::repulsionCutoff(double r0) {
+    //repulsion is zero beyond cutoff, which is r0 for analytic LJ or end of table
+    if(repTable.empty()) return r0;
+    else return sqrt(repTable.sCut);
+}
+
+template <typename CrdT>
+void Network<CrdT>::findRepulsions(const double *crds, double range, ArenaVector<int> &repulsions) {
+    //find pairs of m atoms within range using grid built from same coordinates, ordered as in loop over all unit pairs i<j
+
+    int mId0;
+    for(int i=0; i<nUnits-1; ++i){
+        mId0=units[i].atomM;
+        grid.radius(crds,&crds[CrdT::dim*mId0],range,nearbyAtoms);
+        nearbyUnits.clear();
+        for(int j=0; j<nearbyAtoms.size(); ++j){
+            if(atomUnit[nearbyAtoms[j]]>i) nearbyUnits.push_back(atomUnit[nearbyAtoms[j]]);
+        }
+        sort(nearbyUnits.begin(),nearbyUnits.end());
+        for(int j=0; j<nearbyUnits.size(); ++j){
+            repulsions.push_back(mId0);
+            repulsions.push_back(units[nearbyUnits[j]].atomM);
         }
-        for(int j=0; j<units[fixedLocalUnits[i]].atomsX.n; ++j){
-            x=units[fixedLocalUnits[i]].atomsX.ids[j];
-            if(localAtomMap.count(x)==0){
-                localAtomMap[x]=nLocalAtoms;
-                globalAtomMap[nLocalAtoms]=x;
-                fixedLocalAtoms.push_back(nLocalAtoms);
-                ++nLocalAtoms;
+    }
+}
+
+template <typename CrdT>
+void Network<CrdT>::findLocalInterx(ArenaVector<int> &interx) {
+    //find pairs of triangle edges with no common atom between nearby units of local region, as local atom ids
+    //edges of two units can only meet if m atoms within sum of extents, and edges kept only if bounding boxes within skin
+    //of each other, so pairs which could cross during optimisation included without listing every edge of nearby units
+    //pairs of flexible units listed once, pairs of fixed units omitted as neither edge can move
+
+    ArenaVector<int> flexUnits(flexLocalUnits.begin(),flexLocalUnits.end(),arena);
+    sort(flexUnits.begin(),flexUnits.end());
+    raiseLocalUnitReach();
+    double skin=unitReach*neighbourSkin;
+    double range=2.0*unitReach+skin;
+
+    int edges[6]={0,1,0,2,1,2}; //pairs of x atoms forming triangle edges
+    int uId, uIdNb, a, b, c, d;
+    double *cA, *cB, *cC, *cD;
+    bool apart;
+    for(int i=0; i<flexUnits.size(); ++i){
+        uId=flexUnits[i];
+        grid.radius(atomCrds,&atomCrds[CrdT::dim*units[uId].atomM],range,nearbyAtoms);
+        for(int j=0; j<nearbyAtoms.size(); ++j){
+            uIdNb=atomUnit[nearbyAtoms[j]];
+            if(uIdNb<0 || uIdNb==uId || unitStamps[uIdNb]!=regionStamp) continue;
+            if(uIdNb<uId && binary_search(flexUnits.begin(),flexUnits.end(),uIdNb)) continue;
+            for(int k=0; k<3; ++k){
+                a=units[uId].atomsX.ids[edges[2*k]];
+                b=units[uId].atomsX.ids[edges[2*k+1]];
+                for(int l=0; l<3; ++l){
+                    c=units[uIdNb].atomsX.ids[edges[2*l]];
+                    d=units[uIdNb].atomsX.ids[edges[2*l+1]];
+                    if(a==c || a==d || b==c || b==d) continue;
+                    cA=&atomCrds[CrdT::dim*a];
+                    cB=&atomCrds[CrdT::dim*b];
+                    cC=&atomCrds[CrdT::dim*c];
+                    cD=&atomCrds[CrdT::dim*d];
+                    apart=false;
+                    for(int m=0; m<CrdT::dim; ++m){
+                        if(max(cA[m],cB[m])+skin<min(cC[m],cD[m]) || max(cC[m],cD[m])+skin<min(cA[m],cB[m])) apart=true;
+                    }
+                    if(apart) continue;
+                    interx.push_back(localAtomMap[a]);
+                    interx.push_back(localAtomMap[b]);
+                    interx.push_back(localAtomMap[c]);
+                    interx.push_back(localAtomMap[d]);
+                }
             }
         }
     }
+}
 
-//    cout<<"***"<<endl;
-//    for(int i=0; i<fixedLocalAtoms.size(); ++i) {
-//        cout<<globalAtomMap[fixedLocalAtoms[i]]<<endl;
-//    }
-//    cout<<"***"<<endl;
-//
-//    cout<<"-----"<<endl;
-//    for(int i=0; i<nLocalAtoms;++i){
-//        cout<<globalAtomMap[i]<<endl;
-//    }
-//    cout<<"-----"<<endl;
+template <typename CrdT>
+bool Network<CrdT>::findEdgeIntersections(bool listAll) {
+    //test triangle edges for proper intersection in x-y plane, stopping at first unless listing all
+    //edges binned into uniform grid with cells no smaller than longest edge, so only edges in same cell compared
+    //each edge tested against rest of its cell in one batch, hits between edges sharing an atom ignored
+
+    overlapUnits.clear();
+    int nEdges=3*nUnits;
+    if(nEdges==0) return false;
+
+    //edge end points and bounding boxes
+    vector<int> edgeA(nEdges), edgeB(nEdges);
+    vector<double> xLo(nEdges), yLo(nEdges), xHi(nEdges), yHi(nEdges);
+    double xMin=numeric_limits<double>::max(), yMin=xMin, xMax=-xMin, yMax=-xMin, maxLen=0.0;
+    for(int i=0; i<nUnits; ++i){
+        int a=units[i].atomsX.ids[0], b=units[i].atomsX.ids[1], c=units[i].atomsX.ids[2];
+        int ends[6]={a,b,a,c,b,c};
+        for(int j=0; j<3; ++j){
+            int e=3*i+j;
+            CrdT crdA=getCrd(ends[2*j]), crdB=getCrd(ends[2*j+1]);
+            edgeA[e]=ends[2*j];
+            edgeB[e]=ends[2*j+1];
+            xLo[e]=min(crdA.x,crdB.x);
+            xHi[e]=max(crdA.x,crdB.x);
+            yLo[e]=min(crdA.y,crdB.y);
+            yHi[e]=max(crdA.y,crdB.y);
+            xMin=min(xMin,xLo[e]);
+            xMax=max(xMax,xHi[e]);
+            yMin=min(yMin,yLo[e]);
+            yMax=max(yMax,yHi[e]);
+            maxLen=max(maxLen,max(xHi[e]-xLo[e],yHi[e]-yLo[e]));
+        }
+    }
+
+    //grid dimensions, cells enlarged if grid would be sparse
+    double cellSize=max(maxLen,1e-12);
+    double nCellsSq=((xMax-xMin)/cellSize+1.0)*((yMax-yMin)/cellSize+1.0);
+    if(nCellsSq>4.0*nEdges) cellSize*=sqrt(nCellsSq/(4.0*nEdges));
+    double invCellSize=1.0/cellSize;
+    int nx=int((xMax-xMin)*invCellSize)+1, ny=int((yMax-yMin)*invCellSize)+1;
+    auto cellX=[&](double x){return min(int((x-xMin)*invCellSize),nx-1);};
+    auto cellY=[&](double y){return min(int((y-yMin)*invCellSize),ny-1);};
+
+    //bin edges into every cell their bounding box touches, by counting sort
+    vector<int> cellStart(nx*ny+1,0);
+    for(int e=0; e<nEdges; ++e){
+        for(int iy=cellY(yLo[e]); iy<=cellY(yHi[e]); ++iy){
+            for(int ix=cellX(xLo[e]); ix<=cellX(xHi[e]); ++ix) ++cellStart[iy*nx+ix+1];
+        }
+    }
+    for(int i=0; i<nx*ny; ++i) cellStart[i+1]+=cellStart[i];
+    vector<int> cellFill(cellStart.begin(),cellStart.end()-1), cellEdges(cellStart[nx*ny]);
+    for(int e=0; e<nEdges; ++e){
+        for(int iy=cellY(yLo[e]); iy<=cellY(yHi[e]); ++iy){
+            for(int ix=cellX(xLo[e]); ix<=cellX(xHi[e]); ++ix) cellEdges[cellFill[iy*nx+ix]++]=e;
+        }
+    }
 
+    //pack edges in cell order, so edges of each cell form contiguous block
+    segments.clear();
+    for(int p=0; p<cellEdges.size(); ++p){
+        int e=cellEdges[p];
+        CrdT crdA=getCrd(edgeA[e]), crdB=getCrd(edgeB[e]);
+        segments.add(crdA.x,crdA.y,crdB.x,crdB.y,e);
+    }
+
+    //test each edge against later edges in same cell, pair only counted in cell holding lower corner of overlap of bounding boxes
+    for(int iy=0; iy<ny; ++iy){
+        for(int ix=0; ix<nx; ++ix){
+            int cell=iy*nx+ix;
+            for(int p=cellStart[cell]; p<cellStart[cell+1]-1; ++p){
+                int i=segments.tags[p];
+                if(properIntersectionsBatch(segments.x0[p],segments.y0[p],segments.x1[p],segments.y1[p],segments,p+1,cellStart[cell+1],segmentHits)==0) continue;
+                for(int q=p+1; q<cellStart[cell+1]; ++q){
+                    if(!segmentHits[q-p-1]) continue;
+                    int j=segments.tags[q];
+                    if(edgeA[i]==edgeA[j] || edgeA[i]==edgeB[j] || edgeB[i]==edgeA[j] || edgeB[i]==edgeB[j]) continue;
+                    if(cellX(max(xLo[i],xLo[j]))!=ix || cellY(max(yLo[i],yLo[j]))!=iy) continue;
+                    overlapUnits.push_back(min(i,j)/3);
+                    overlapUnits.push_back(max(i,j)/3);
+                    if(!listAll) return true;
+                }
+            }
+        }
+    }
 
+    return overlapUnits.size()>0;
 }
 
 template <typename CrdT>
@@ -500,15 +928,16 @@ void Network<CrdT>::calculateRingStatistics() {
     //calculate ring statistics, ring statistics around each ring, and aboav-weaire analysis
 
     //calculate distribution of ring sizes and store unique ring sizes
+    const AdjacencyCSR &ringUnits=topology.ringUnits, &ringRings=topology.ringRings;
     vector<int> ringSizes;
-    for(int i=0; i<nRings; ++i) ringSizes.push_back(rings[i].units.n);
+    for(int i=0; i<nRings; ++i) ringSizes.push_back(ringUnits.size(i));
     DiscreteDistribution ringStats(ringSizes);
     ringStatistics=ringStats;
 
     //calculate distribution of ring sizes excluding edge rings
     ringSizes.clear();
     for(int i=0; i<nRings; ++i){
-        if(rings[i].rings.full) ringSizes.push_back(rings[i].units.n);
+        if(topology.ringBulk[i]) ringSizes.push_back(ringUnits.size(i));
     }
     ringStats=DiscreteDistribution(ringSizes);
     bulkRingStatistics=ringStats;
@@ -520,12 +949,12 @@ void Network<CrdT>::calculateRingStatistics() {
         int s=ringStatistics.x[i];
         ringSizes.clear();
         for(int j=0; j<nRings; ++j){//get ring sizes around ring of given size
-            if(rings[j].rings.full){//only include rings not on edge
-                if(rings[j].units.n==s){
-                    for(int k=0; k<rings[j].rings.n; ++k){
-                        ringRef=rings[j].rings.ids[k];
-                        if(rings[ringRef].rings.full){
-                            ringSizes.push_back(rings[ringRef].units.n);
+            if(topology.ringBulk[j]){//only include rings not on edge
+                if(ringUnits.size(j)==s){
+                    for(int k=0; k<ringRings.size(j); ++k){
+                        ringRef=ringRings(j,k);
+                        if(topology.ringBulk[ringRef]){
+                            ringSizes.push_back(ringUnits.size(ringRef));
                         }
                     }
                 }
@@ -553,7 +982,7 @@ void Network<CrdT>::calculateRingStatistics() {
 
     //initialise ring colours
     ringColours.resize(nRings,col_vector<int>(4));
-    for(int i=0; i<nRings; ++i) ringColours[i][0]=rings[i].units.n;
+    for(int i=0; i<nRings; ++i) ringColours[i][0]=ringUnits.size(i);
 }
 
 template <typename CrdT>
@@ -565,14 +994,15 @@ void Network<CrdT>::calculateRingAreas() {
     double area;
     double mm_sq=bondLenDistMM.mean*bondLenDistMM.mean; //to make dimensionless
     int ringSize,m0, m1;
+    const AdjacencyCSR &ringUnits=topology.ringUnits;
     for(int i=0; i<nRings; ++i){
         area=0.0;
-        ringSize=rings[i].units.n;
+        ringSize=ringUnits.size(i);
         for(int j=0; j<ringSize; ++j){
-            m0=units[rings[i].units.ids[j]].atomM;
-            m1=units[rings[i].units.ids[(j+1)%ringSize]].atomM;
-            area+=atoms[m0].coordinate.x*atoms[m1].coordinate.y;
-            area-=atoms[m1].coordinate.x*atoms[m0].coordinate.y;
+            m0=topology.unitAtomM[ringUnits(i,j)];
+            m1=topology.unitAtomM[ringUnits(i,(j+1)%ringSize)];
+            area+=getCrd(m0).x*getCrd(m1).y;
+            area-=getCrd(m1).x*getCrd(m0).y;
         }
         area=fabs(0.5*area/mm_sq);
         ringSizeAreas[ringSize].push_back(area);
@@ -593,6 +1023,8 @@ void Network<CrdT>::calculateBondDistributions(bool fullDist) {
 
     //flag whether to write full distributions
     writeFullDistributions=fullDist;
+    const vector<int> &unitAtomM=topology.unitAtomM;
+    const AdjacencyCSR &unitAtomsX=topology.unitAtomsX, &unitUnits=topology.unitUnits;
 
     //M-X length
     vector<double> bondLengths;
@@ -600,11 +1032,11 @@ void Network<CrdT>::calculateBondDistributions(bool fullDist) {
     int m,x;
     CrdT crdM, crdX, crdMX;
     for(int i=0; i<nUnits; ++i){
-        m=units[i].atomM;
-        crdM=atoms[m].coordinate;
-        for(int j=0; j<units[i].atomsX.n; ++j){
-            x=units[i].atomsX.ids[j];
-            crdX=atoms[x].coordinate;
+        m=unitAtomM[i];
+        crdM=getCrd(m);
+        for(int j=0; j<unitAtomsX.size(i); ++j){
+            x=unitAtomsX(i,j);
+            crdX=getCrd(x);
             crdMX=crdM-crdX;
             bondLengths.push_back(crdMX.norm());
         }
@@ -617,12 +1049,12 @@ void Network<CrdT>::calculateBondDistributions(bool fullDist) {
     int x0, x1;
     CrdT crdX0, crdX1, crdXX;
     for(int i=0; i<nUnits; ++i){
-        for(int j=0; j<units[i].atomsX.n-1; ++j){
-            x0=units[i].atomsX.ids[j];
-            crdX0=atoms[x0].coordinate;
-            for(int k=j+1; k<units[i].atomsX.n; ++k){
-                x1=units[i].atomsX.ids[k];
-                crdX1=atoms[x1].coordinate;
+        for(int j=0; j<unitAtomsX.size(i)-1; ++j){
+            x0=unitAtomsX(i,j);
+            crdX0=getCrd(x0);
+            for(int k=j+1; k<unitAtomsX.size(i); ++k){
+                x1=unitAtomsX(i,k);
+                crdX1=getCrd(x1);
                 crdXX=crdX1-crdX0;
                 bondLengths.push_back(crdXX.norm());
             }
@@ -636,12 +1068,12 @@ void Network<CrdT>::calculateBondDistributions(bool fullDist) {
     int m0, m1;
     CrdT crdM0, crdM1, crdMM;
     for(int i=0; i<nUnits; ++i){
-        m0=units[i].atomM;
-        crdM0=atoms[m0].coordinate;
-        for(int j=0; j<units[i].units.n; ++j){
-            m1=units[units[i].units.ids[j]].atomM;
+        m0=unitAtomM[i];
+        crdM0=getCrd(m0);
+        for(int j=0; j<unitUnits.size(i); ++j){
+            m1=unitAtomM[unitUnits(i,j)];
             if(m0<m1){//prevent double  counting
-                crdM1=atoms[m1].coordinate;
+                crdM1=getCrd(m1);
                 crdMM=crdM1-crdM0;
                 bondLengths.push_back(crdMM.norm());
             }
@@ -659,19 +1091,19 @@ void Network<CrdT>::calculateBondDistributions(bool fullDist) {
     double theta0, theta1;
     for(int i=0; i<nUnits; ++i){
         u0=i;
-        m0=units[u0].atomM;
-        x00=units[u0].atomsX.ids[0];
-        x01=units[u0].atomsX.ids[1];
-        x02=units[u0].atomsX.ids[2];
-        crdM0=atoms[m0].coordinate;
-        for(int j=0; j<units[i].units.n; ++j){
-            u1=units[i].units.ids[j];
+        m0=unitAtomM[u0];
+        x00=unitAtomsX(u0,0);
+        x01=unitAtomsX(u0,1);
+        x02=unitAtomsX(u0,2);
+        crdM0=getCrd(m0);
+        for(int j=0; j<unitUnits.size(i); ++j){
+            u1=unitUnits(i,j);
             if(u0<u1){//prevent double counting
-                m1=units[u1].atomM;
-                x10=units[u1].atomsX.ids[0];
-                x11=units[u1].atomsX.ids[1];
-                x12=units[u1].atomsX.ids[2];
-                crdM1=atoms[m1].coordinate;
+                m1=unitAtomM[u1];
+                x10=unitAtomsX(u1,0);
+                x11=unitAtomsX(u1,1);
+                x12=unitAtomsX(u1,2);
+                crdM1=getCrd(m1);
                 //find bridging x atom
                 if(x00==x10) x=x00;
                 else if(x01==x10) x=x01;
@@ -683,7 +1115,7 @@ void Network<CrdT>::calculateBondDistributions(bool fullDist) {
                 else if(x01==x12) x=x01;
                 else if(x02==x12) x=x02;
                 else cout<<"ERROR IN BOND ANGLE CALCULATION"<<endl;
-                crdX=atoms[x].coordinate;
+                crdX=getCrd(x);
                 crdMX0=crdM0-crdX;
                 crdMX1=crdM1-crdX;
                 crdMX0.normalise();
@@ -703,10 +1135,10 @@ void Network<CrdT>::calculateBondDistributions(bool fullDist) {
     double theta;
     CrdT crdM2, crdMM0, crdMM1, crdMM2;
     for(int i=0; i<nUnits; ++i){
-        crdM=atoms[units[i].atomM].coordinate;
-        if(units[i].units.n==2){
-            crdM0=atoms[units[units[i].units.ids[0]].atomM].coordinate;
-            crdM1=atoms[units[units[i].units.ids[1]].atomM].coordinate;
+        crdM=getCrd(unitAtomM[i]);
+        if(unitUnits.size(i)==2){
+            crdM0=getCrd(unitAtomM[unitUnits(i,0)]);
+            crdM1=getCrd(unitAtomM[unitUnits(i,1)]);
             crdMM0=crdM0-crdM;
             crdMM1=crdM1-crdM;
             crdMM0.normalise();
@@ -714,10 +1146,10 @@ void Network<CrdT>::calculateBondDistributions(bool fullDist) {
             theta=acos(crdMM0*crdMM1);
             bondAngles.push_back(theta);
         }
-        else if(units[i].units.n==3){
-            crdM0=atoms[units[units[i].units.ids[0]].atomM].coordinate;
-            crdM1=atoms[units[units[i].units.ids[1]].atomM].coordinate;
-            crdM2=atoms[units[units[i].units.ids[2]].atomM].coordinate;
+        else if(unitUnits.size(i)==3){
+            crdM0=getCrd(unitAtomM[unitUnits(i,0)]);
+            crdM1=getCrd(unitAtomM[unitUnits(i,1)]);
+            crdM2=getCrd(unitAtomM[unitUnits(i,2)]);
             crdMM0=crdM0-crdM;
             crdMM1=crdM1-crdM;
             crdMM2=crdM2-crdM;
@@ -741,11 +1173,31 @@ void Network<CrdT>::calculateBondDistributions(bool fullDist) {
 template <typename CrdT>
 void Network<CrdT>::write(string prefix, bool special, Logfile &logfile) {
     //write network and analysis to files
-    writeNetwork(prefix,logfile);
+    writeFormats(prefix,logfile);
     if(special) writeNetworkSpecial(prefix,logfile);
     writeAnalysis(prefix,logfile);
 }
 
+template <typename CrdT>
+void Network<CrdT>::getFrame(TrajectoryFrame &frame) {
+    //copy network state for trajectory, only atoms and rings after first ids as earlier ones unchanged since previous frame
+
+    frame.elements.resize(nAtoms-frame.firstAtom);
+    for(int i=frame.firstAtom; i<nAtoms; ++i) frame.elements[i-frame.firstAtom]=atoms[i].element;
+    frame.crds=atomCrds;
+    frame.unitAtoms.resize(4*nUnits);
+    for(int i=0; i<nUnits; ++i){
+        frame.unitAtoms[4*i]=units[i].atomM;
+        for(int j=0; j<3; ++j) frame.unitAtoms[4*i+1+j]=units[i].atomsX.ids[j];
+    }
+    frame.ringOffsets.assign(1,0);
+    frame.ringUnits.clear();
+    for(int i=frame.firstRing; i<nRings; ++i){
+        for(int j=0; j<rings[i].units.n; ++j) frame.ringUnits.push_back(rings[i].units.ids[j]);
+        frame.ringOffsets.push_back(frame.ringUnits.size());
+    }
+}
+
 template <typename CrdT>
 void Network<CrdT>::writeAnalysis(string prefix, Logfile &logfile) {
     //write analysis to file
@@ -753,7 +1205,7 @@ void Network<CrdT>::writeAnalysis(string prefix, Logfile &logfile) {
     logfile.log("Writing network analysis","","",0,false);
     //set up analysis file
     string analysisFilename = prefix + "_analysis.out";
-    ofstream analysisFile(analysisFilename,ios::in|ios::trunc);
+    TextWriter analysisFile(analysisFilename);
 
     //overlap
     writeFileValue(analysisFile,"Valid geometry",true);
@@ -761,11 +1213,11 @@ void Network<CrdT>::writeAnalysis(string prefix, Logfile &logfile) {
 
     //ring statistics
     writeFileValue(analysisFile,"p_n, <n>, s for total, bulk, individual",true);
-    analysisFile << fixed << showpoint << setprecision(1);
+    analysisFile.setFixed(1);
     //total ring statistics
     vector<int> ringSizes=ringStatistics.getValues();
     writeFileVector(analysisFile,ringSizes,20);
-    analysisFile << fixed << showpoint << setprecision(8);
+    analysisFile.setFixed(8);
     vector<double> data=ringStatistics.getProbabilities();
     data.push_back(ringStatistics.mean);
     data.push_back(double(ringStatistics.sampleSize));
@@ -814,11 +1266,11 @@ void Network<CrdT>::writeAnalysis(string prefix, Logfile &logfile) {
         string mmAnalysisFilename = prefix + "_analysis_mm.out";
         string mxmAnalysisFilename = prefix + "_analysis_mxm.out";
         string mmmAnalysisFilename = prefix + "_analysis_mmm.out";
-        ofstream mxAnalysisFile(mxAnalysisFilename,ios::in|ios::trunc);
-        ofstream xxAnalysisFile(xxAnalysisFilename,ios::in|ios::trunc);
-        ofstream mmAnalysisFile(mmAnalysisFilename,ios::in|ios::trunc);
-        ofstream mxmAnalysisFile(mxmAnalysisFilename,ios::in|ios::trunc);
-        ofstream mmmAnalysisFile(mmmAnalysisFilename,ios::in|ios::trunc);
+        TextWriter mxAnalysisFile(mxAnalysisFilename);
+        TextWriter xxAnalysisFile(xxAnalysisFilename);
+        TextWriter mmAnalysisFile(mmAnalysisFilename);
+        TextWriter mxmAnalysisFile(mxmAnalysisFilename);
+        TextWriter mmmAnalysisFile(mmmAnalysisFilename);
         vector<double> rawDistribution=bondLenDistMX.getValues();
         writeFileVectorTranspose(mxAnalysisFile,rawDistribution);
         rawDistribution=bondLenDistXX.getValues();
@@ -872,10 +1324,311 @@ void Network<CrdT>::kill(string prefix, Logfile &logfile) {
     //clean, initialise and get ring colours
     clean();
     ringColours.resize(nRings,col_vector<int>(2));
-    for(int i=0; i<nRings; ++i) ringColours[i][0]=rings[i].units.n;
+    for(int i=0; i<nRings; ++i) ringColours[i][0]=topology.ringUnits.size(i);
 
     //write network only - not analysis
-    writeNetwork(prefix,logfile);
+    writeFormats(prefix,logfile);
+}
+
+template <typename CrdT>
+void Network<CrdT>::writeFormats(string prefix, Logfile &logfile) {
+    //write network as text files, binary container or both
+    if(networkFormat!=1) writeNetwork(prefix,logfile);
+    if(networkFormat!=0) writeBinary(prefix,logfile);
+}
+
+template <typename CrdT>
+void Network<CrdT>::readText(string prefix, double additionalParams, Logfile &logfile) {
+    //load network from atom, unit, ring and connection text files, each mapped into memory and split into lines
+    //lines parsed in parallel straight into atoms, units and rings, mutual connections then made serially in file order
+    //z coordinate of 3D network set from additional parameter, as text seeds are planar
+
+    //set up file names
+    string atomFilename=prefix+"_atoms.out";
+    string unitFilename=prefix+"_units.out";
+    string ringFilename=prefix+"_rings.out";
+    string cnxFilename=prefix+"_connections.out";
+
+    //check files data
+    MappedFile atomFile, unitFile, ringFile, cnxFile;
+    if(!atomFile.open(atomFilename)) logfile.errorlog("Cannot find atom input file","critical");
+    if(!unitFile.open(unitFilename)) logfile.errorlog("Cannot find unit input file","critical");
+    if(!ringFile.open(ringFilename)) logfile.errorlog("Cannot find ring input file","critical");
+    if(!cnxFile.open(cnxFilename)) logfile.errorlog("Cannot find connection input file","critical");
+    LineIndex lines;
+    int badLine;
+
+    //set up all atoms with element, coordination and x-y coordinate
+    lines.build(atomFile.begin(),atomFile.end());
+    nAtoms=lines.size();
+    atoms.resize(nAtoms);
+    atomCrds.assign(CrdT::dim*nAtoms,additionalParams);
+    atomUnit.assign(nAtoms,-1);
+    badLine=nAtoms;
+    #pragma omp parallel for schedule(static) reduction(min:badLine)
+    for(int i=0; i<nAtoms; ++i){
+        double v[4];
+        if(parseDoubles(lines.starts[i],lines.ends[i],v,4)!=4){
+            badLine=min(badLine,i);
+            continue;
+        }
+        atoms[i]=Atom<CrdT>(i,int(v[0]),int(v[1]));
+        atomCrds[CrdT::dim*i]=v[2];
+        atomCrds[CrdT::dim*i+1]=v[3];
+    }
+    if(badLine<nAtoms) logfile.errorlog("Cannot read line "+to_string(lines.numbers[badLine])+" of "+atomFilename,"critical");
+
+    //set up units with m atom and unit-atom connections
+    lines.build(unitFile.begin(),unitFile.end());
+    int nU=lines.size();
+    units.reserve(nU);
+    for(int i=0; i<nU; ++i) units.push_back(Unit(i));
+    nUnits=nU;
+    badLine=nU;
+    #pragma omp parallel for schedule(static) reduction(min:badLine)
+    for(int i=0; i<nU; ++i){
+        int v[4];
+        bool valid=(parseInts(lines.starts[i],lines.ends[i],v,4)==4);
+        for(int j=0; j<4 && valid; ++j) valid=(v[j]>=0 && v[j]<nAtoms);
+        if(!valid){
+            badLine=min(badLine,i);
+            continue;
+        }
+        setUnitAtomM(i,v[0]);
+        for(int j=1; j<4; ++j) units[i].atomsX.add(v[j]);
+    }
+    if(badLine<nU) logfile.errorlog("Cannot read line "+to_string(lines.numbers[badLine])+" of "+unitFilename,"critical");
+
+    //set up rings with ring-unit connections, then unit-ring connections in ring order
+    lines.build(ringFile.begin(),ringFile.end());
+    int nR=lines.size();
+    rings.resize(nR);
+    nRings=nR;
+    badLine=nR;
+    #pragma omp parallel for schedule(static) reduction(min:badLine)
+    for(int i=0; i<nR; ++i){
+        int size=countTokens(lines.starts[i],lines.ends[i]);
+        rings[i]=Ring(i,size,size);
+        Connector<ringConnectorSize> &ringUnits=rings[i].units;
+        bool valid=(parseInts(lines.starts[i],lines.ends[i],ringUnits.ids,size)==size);
+        for(int j=0; j<size && valid; ++j) valid=(ringUnits.ids[j]>=0 && ringUnits.ids[j]<nU);
+        if(!valid){
+            badLine=min(badLine,i);
+            continue;
+        }
+        ringUnits.n=size;
+    }
+    if(badLine<nR) logfile.errorlog("Cannot read line "+to_string(lines.numbers[badLine])+" of "+ringFilename,"critical");
+    for(int i=0; i<nR; ++i){
+        for(int j=0; j<rings[i].units.n; ++j) units[rings[i].units.ids[j]].rings.add(i);
+    }
+
+    //add unit-unit then ring-ring connections, each block a count followed by pairs
+    lines.build(cnxFile.begin(),cnxFile.end());
+    int nUU=0, nRR=0;
+    bool valid=(lines.size()>0 && parseInts(lines.starts[0],lines.ends[0],&nUU,1)==1 && nUU>=0 && lines.size()>nUU+1
+                && parseInts(lines.starts[nUU+1],lines.ends[nUU+1],&nRR,1)==1 && nRR>=0 && lines.size()>=nUU+nRR+2);
+    if(!valid) logfile.errorlog("Cannot read connection counts in "+cnxFilename,"critical");
+    vector<int> pairs(2*(nUU+nRR));
+    badLine=lines.size();
+    #pragma omp parallel for schedule(static) reduction(min:badLine)
+    for(int i=0; i<nUU+nRR; ++i){
+        int line=(i<nUU) ? i+1 : i+2;
+        int limit=(i<nUU) ? nU : nR;
+        if(parseInts(lines.starts[line],lines.ends[line],&pairs[2*i],2)!=2 || pairs[2*i]<0 || pairs[2*i]>=limit || pairs[2*i+1]<0 || pairs[2*i+1]>=limit){
+            badLine=min(badLine,line);
+        }
+    }
+    if(badLine<lines.size()) logfile.errorlog("Cannot read line "+to_string(lines.numbers[badLine])+" of "+cnxFilename,"critical");
+    for(int i=0; i<nUU; ++i) addUnitUnitCnx(pairs[2*i],pairs[2*i+1]);
+    for(int i=nUU; i<nUU+nRR; ++i) addRingRingCnx(pairs[2*i],pairs[2*i+1]);
+
+    logfile.log("Atoms read from: ", atomFilename, "", 1, false);
+    logfile.log("Units read from: ", unitFilename, "", 1, false);
+    logfile.log("Rings read from: ", ringFilename, "", 1, false);
+    logfile.log("Additional connections read from: ", cnxFilename, "", 1, false);
+}
+
+template <typename CrdT>
+bool Network<CrdT>::readBinary(string filename, double additionalParams) {
+    //load network from binary container, with same content as text files but coordinates at full precision
+    //counts checked against file size and ids checked against counts before network built, false if invalid
+    //2D coordinates given additional parameter as z for 3D network, as when reading text files
+
+    BinaryReader reader;
+    uint32_t version;
+    if(!reader.read(filename) || !reader.header(networkMagic,version) || version!=networkVersion) return false;
+
+    //counts of atoms, units, rings, ring members and additional connections
+    int64_t dim=reader.get<int32_t>(), nA=reader.get<int32_t>(), nU=reader.get<int32_t>(), nR=reader.get<int32_t>();
+    int64_t nRU=reader.get<int32_t>(), nUU=reader.get<int32_t>(), nRR=reader.get<int32_t>();
+    if(!reader.valid || dim<2 || dim>CrdT::dim || nA<0 || nU<0 || nR<0 || nRU<0 || nUU<0 || nRR<0) return false;
+    int64_t bytes=nA*(2*sizeof(int32_t)+dim*sizeof(double))+(4*nU+nR+1+nRU+2*nUU+2*nRR)*sizeof(int32_t);
+    if(bytes!=reader.remaining()) return false;
+
+    //sections in order
+    vector<int32_t> elements(nA), coordinations(nA), unitAtoms(4*nU), ringStart(nR+1), ringUnits(nRU), unitUnitCnxs(2*nUU), ringRingCnxs(2*nRR);
+    vector<double> crds(dim*nA);
+    reader.getArray(elements.data(),nA);
+    reader.getArray(coordinations.data(),nA);
+    reader.getArray(crds.data(),dim*nA);
+    reader.getArray(unitAtoms.data(),4*nU);
+    reader.getArray(ringStart.data(),nR+1);
+    reader.getArray(ringUnits.data(),nRU);
+    reader.getArray(unitUnitCnxs.data(),2*nUU);
+    reader.getArray(ringRingCnxs.data(),2*nRR);
+    if(!reader.valid) return false;
+
+    //check ids in range
+    if(ringStart[0]!=0 || ringStart[nR]!=nRU) return false;
+    for(int i=0; i<nR; ++i) if(ringStart[i+1]<ringStart[i]) return false;
+    for(int i=0; i<4*nU; ++i) if(unitAtoms[i]<0 || unitAtoms[i]>=nA) return false;
+    for(int i=0; i<nRU; ++i) if(ringUnits[i]<0 || ringUnits[i]>=nU) return false;
+    for(int i=0; i<2*nUU; ++i) if(unitUnitCnxs[i]<0 || unitUnitCnxs[i]>=nU) return false;
+    for(int i=0; i<2*nRR; ++i) if(ringRingCnxs[i]<0 || ringRingCnxs[i]>=nR) return false;
+
+    //set up atoms
+    atoms.reserve(nA);
+    atomCrds.reserve(CrdT::dim*nA);
+    double c[3]={0.0,0.0,additionalParams};
+    CrdT crd;
+    for(int i=0; i<nA; ++i){
+        for(int d=0; d<dim; ++d) c[d]=crds[dim*i+d];
+        crd.load(c);
+        Atom<CrdT> atom(i,elements[i],coordinations[i]);
+        addAtom(atom,crd);
+    }
+
+    //set up units with m atom and unit-atom connections
+    units.reserve(nU);
+    for(int i=0; i<nU; ++i){
+        Unit triangle(i);
+        addUnit(triangle);
+    }
+    for(int i=0; i<nU; ++i){
+        setUnitAtomM(i,unitAtoms[4*i]);
+        for(int j=1; j<4; ++j) addUnitAtomXCnx(i,unitAtoms[4*i+j]);
+    }
+
+    //set up rings with unit-ring connections
+    rings.reserve(nR);
+    for(int i=0; i<nR; ++i){
+        int size=ringStart[i+1]-ringStart[i];
+        Ring ring(i,size,size);
+        addRing(ring);
+    }
+    for(int i=0; i<nR; ++i){
+        for(int j=ringStart[i]; j<ringStart[i+1]; ++j) addUnitRingCnx(ringUnits[j],i);
+    }
+
+    //add additional connections
+    for(int i=0; i<nUU; ++i) addUnitUnitCnx(unitUnitCnxs[2*i],unitUnitCnxs[2*i+1]);
+    for(int i=0; i<nRR; ++i) addRingRingCnx(ringRingCnxs[2*i],ringRingCnxs[2*i+1]);
+
+    return true;
 }
+
+template <typename CrdT>
+void Network<CrdT>::writeBinary(string prefix, Logfile &logfile) {
+    //write network to binary container from topology snapshot, ids match indices after cleaning
+    //layout: header, counts, element, coordination, coordinates, unit atoms, ring offsets and units, connection pairs
+
+    string binFilename=prefix+networkBinarySuffix;
+
+    //additional connections, each pair once
+    vector<int32_t> unitUnitCnxs, ringRingCnxs;
+    for(int i=0; i<nUnits; ++i){
+        for(int j=0; j<topology.unitUnits.size(i); ++j){
+            if(i<topology.unitUnits(i,j)){
+                unitUnitCnxs.push_back(i);
+                unitUnitCnxs.push_back(topology.unitUnits(i,j));
+            }
+        }
+    }
+    for(int i=0; i<nRings; ++i){
+        for(int j=0; j<topology.ringRings.size(i); ++j){
+            if(i<topology.ringRings(i,j)){
+                ringRingCnxs.push_back(i);
+                ringRingCnxs.push_back(topology.ringRings(i,j));
+            }
+        }
+    }
+    int nRingUnits=0;
+    for(int i=0; i<nRings; ++i) nRingUnits+=topology.ringUnits.size(i);
+
+    //fill buffer
+    BinaryWriter writer;
+    writer.buffer.reserve(64+nAtoms*(8+8*CrdT::dim)+4*(4*nUnits+nRings+1+nRingUnits)+4*(unitUnitCnxs.size()+ringRingCnxs.size()));
+    writer.header(networkMagic,networkVersion);
+    writer.put<int32_t>(CrdT::dim);
+    writer.put<int32_t>(nAtoms);
+    writer.put<int32_t>(nUnits);
+    writer.put<int32_t>(nRings);
+    writer.put<int32_t>(nRingUnits);
+    writer.put<int32_t>(unitUnitCnxs.size()/2);
+    writer.put<int32_t>(ringRingCnxs.size()/2);
+    for(int i=0; i<nAtoms; ++i) writer.put<int32_t>(atoms[i].element);
+    for(int i=0; i<nAtoms; ++i) writer.put<int32_t>(atoms[i].coordination);
+    writer.putArray(atomCrds.data(),CrdT::dim*nAtoms);
+    for(int i=0; i<nUnits; ++i){
+        writer.put<int32_t>(topology.unitAtomM[i]);
+        for(int j=0; j<3; ++j) writer.put<int32_t>(topology.unitAtomsX.begin(i)[j]);
+    }
+    int32_t offset=0;
+    writer.put<int32_t>(offset);
+    for(int i=0; i<nRings; ++i){
+        offset+=topology.ringUnits.size(i);
+        writer.put<int32_t>(offset);
+    }
+    for(int i=0; i<nRings; ++i){
+        for(int j=0; j<topology.ringUnits.size(i); ++j) writer.put<int32_t>(topology.ringUnits(i,j));
+    }
+    writer.putArray(unitUnitCnxs.data(),unitUnitCnxs.size());
+    writer.putArray(ringRingCnxs.data(),ringRingCnxs.size());
+
+    if(writer.write(binFilename)) logfile.log("Binary network written to: ", binFilename, "", 1, false);
+    else logfile.errorlog("Cannot write binary network file "+binFilename,"write ");
+}
+template <typename CrdT>
+void Network<CrdT>::logMemory(Logfile &logfile, int indent, bool breakdown) {
+    //estimate bytes held by each container from capacities, log total and per ring, optionally by container
+    //map nodes counted with tree pointers and colour, heap allocator overheads not included
+
+    const size_t mapNode=4*sizeof(void*);
+    size_t connectorBytes=0;
+    for(int i=0; i<rings.size(); ++i) connectorBytes+=rings[i].units.heapBytes()+rings[i].rings.heapBytes();
+    size_t analysisBytes=ringStatistics.memory()+bulkRingStatistics.memory();
+    analysisBytes+=bondLenDistXX.memory()+bondLenDistMX.memory()+bondLenDistMM.memory()+bondAngDistMXM.memory()+bondAngDistMMM.memory();
+    for(typename map<int,DiscreteDistribution>::iterator it=indRingStatistics.begin(); it!=indRingStatistics.end(); ++it) analysisBytes+=mapNode+sizeof(int)+it->second.memory();
+    for(typename map<int,ContinuousDistribution>::iterator it=ringAreas.begin(); it!=ringAreas.end(); ++it) analysisBytes+=mapNode+sizeof(int)+it->second.memory();
+    for(typename map<int,DiscreteDistribution>::iterator it=clusterDistributions.begin(); it!=clusterDistributions.end(); ++it) analysisBytes+=mapNode+sizeof(int)+it->second.memory();
+    analysisBytes+=percolation.size()*(mapNode+sizeof(int)+sizeof(bool));
+    analysisBytes+=aboavWeaireParameters.capacity()*sizeof(double);
+    for(int i=0; i<ringColours.size(); ++i) analysisBytes+=sizeof(col_vector<int>)+ringColours[i].n*sizeof(int);
+
+    vector<string> names={"atoms","coordinates","units","rings","ring connector overflow","boundary","spatial grid","local region","arena","topology","analysis"};
+    vector<size_t> bytes(names.size());
+    bytes[0]=atoms.capacity()*sizeof(Atom<CrdT>);
+    bytes[1]=atomCrds.capacity()*sizeof(double);
+    bytes[2]=units.capacity()*sizeof(Unit);
+    bytes[3]=rings.capacity()*sizeof(Ring);
+    bytes[4]=connectorBytes;
+    bytes[5]=(boundaryUnits.capacity()+boundaryStatus.capacity())*sizeof(int);
+    bytes[6]=grid.memory();
+    bytes[7]=(localAtomMap.capacity()+globalAtomMap.capacity()+unitStamps.capacity()+atomStamps.capacity())*sizeof(int);
+    bytes[7]+=(flexLocalUnits.capacity()+fixedLocalUnits.capacity()+fixedLocalAtoms.capacity())*sizeof(int);
+    bytes[8]=arena.getCapacity();
+    bytes[9]=topology.memory();
+    bytes[10]=analysisBytes;
+    size_t total=0;
+    for(int i=0; i<bytes.size(); ++i) total+=bytes[i];
+
+    logfile.log("Memory footprint (kB): ",to_string(total/1024),"",indent,false);
+    if(nRings>0) logfile.log("Memory per ring (B): ",to_string(total/nRings),"",indent+1,false);
+    if(breakdown){
+        for(int i=0; i<bytes.size(); ++i) logfile.log(names[i]+" (kB): ",to_string(bytes[i]/1024),"",indent+1,false);
+    }
+}
+
 //template <typename CrdT>
 //Network<CrdT>::
@@ -0,0 +1,44 @@
+//Tabulated pair potentials, cubic splines on evenly spaced grid in squared separation.
+#ifndef MX2_PAIRTABLE_H
+#define MX2_PAIRTABLE_H
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include "easyIO.h"
+
+using namespace std;
+
+const int defaultTableIntervals=2048; //number of spline intervals in generated and resampled tables
+
+template <typename T>
+struct PairTable{
+    //pair potential U(s), s=r^2, as cubic hermite spline on evenly spaced grid in s
+    //zero beyond cutoff, linearly extrapolated below start of grid
+
+    int nIntervals; //number of spline intervals, 0 if no table
+    T s0, sCut, invH; //start of grid, cutoff, inverse grid spacing
+    T u0, du0; //energy and derivative at start of grid
+    vector<T> coeffs; //four per interval, U(t)=c0+t(c1+t(c2+t*c3)) with t in [0,1]
+
+    //constructors
+    PairTable();
+    template <typename U> PairTable(const PairTable<U> &source);
+
+    //set up
+    void setHermite(double sStart, double sEnd, vector<double> &u, vector<double> &du);
+    void setLJ(double epsilon, double r0, int n=defaultTableIntervals);
+    bool read(string filename, int n=defaultTableIntervals);
+
+    //lookup
+    bool empty() const;
+    void evaluate(T s, T &u, T &du) const;
+    T energy(T s) const;
+    T forceFactor(T s) const;
+};
+
+#include "pairTable.tpp"
+
+#endif //MX2_PAIRTABLE_H
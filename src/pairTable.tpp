@@ -0,0 +1,175 @@
+#include "pairTable.h"
+
+//##### CONSTRUCTORS #####
+template <typename T>
+PairTable<T>::PairTable() {
+    //default constructor, no table
+    nIntervals=0;
+    s0=0.0;
+    sCut=0.0;
+    invH=0.0;
+    u0=0.0;
+    du0=0.0;
+}
+
+template <typename T>
+template <typename U>
+PairTable<T>::PairTable(const PairTable<U> &source) {
+    //copy table changing floating point type
+    nIntervals=source.nIntervals;
+    s0=source.s0;
+    sCut=source.sCut;
+    invH=source.invH;
+    u0=source.u0;
+    du0=source.du0;
+    coeffs=vector<T>(source.coeffs.begin(),source.coeffs.end());
+}
+
+//##### SET UP #####
+template <typename T>
+void PairTable<T>::setHermite(double sStart, double sEnd, vector<double> &u, vector<double> &du) {
+    //set coefficients from energy and derivative wrt s at n+1 evenly spaced grid points
+    nIntervals=u.size()-1;
+    double h=(sEnd-sStart)/nIntervals;
+    s0=sStart;
+    sCut=sEnd;
+    invH=1.0/h;
+    u0=u[0];
+    du0=du[0];
+    coeffs.resize(4*nIntervals);
+    for(int i=0; i<nIntervals; ++i){
+        double d0=h*du[i], d1=h*du[i+1]; //derivatives wrt t
+        coeffs[4*i]=u[i];
+        coeffs[4*i+1]=d0;
+        coeffs[4*i+2]=3.0*(u[i+1]-u[i])-2.0*d0-d1;
+        coeffs[4*i+3]=2.0*(u[i]-u[i+1])+d0+d1;
+    }
+}
+
+template <typename T>
+void PairTable<T>::setLJ(double epsilon, double r0, int n) {
+    //generate table for shifted and truncated LJ potential U=ep*(r-24-2r-12)+ep, from half r0 to cutoff at r0
+    double r02=r0*r0;
+    double sStart=0.25*r02, h=(r02-sStart)/n;
+    vector<double> u(n+1), du(n+1);
+    for(int i=0; i<=n; ++i){
+        double s=sStart+i*h;
+        double d12=pow(r02/s,6);
+        double d24=d12*d12;
+        u[i]=epsilon*(d24-2.0*d12)+epsilon;
+        du[i]=12.0*epsilon*(d12-d24)/s;
+    }
+    u[n]=0.0;
+    du[n]=0.0;
+    setHermite(sStart,r02,u,du);
+}
+
+template <typename T>
+bool PairTable<T>::read(string filename, int n) {
+    //read table of separation and energy, resample onto evenly spaced grid in s through clamped cubic spline
+    //rows must be in increasing separation, last row is cutoff
+    ifstream file(filename, ios::in);
+    if(!file.good()) return false;
+    vector< vector<double> > rows;
+    readFileAll(file,rows);
+    file.close();
+    vector<double> s, u;
+    for(int i=0; i<rows.size(); ++i){
+        if(rows[i].size()<2) continue;
+        s.push_back(rows[i][0]*rows[i][0]);
+        u.push_back(rows[i][1]);
+    }
+    int m=s.size();
+    if(m<3) return false;
+    for(int i=1; i<m; ++i) if(s[i]<=s[i-1]) return false;
+
+    //end slopes from one-sided three point differences
+    double h0=s[1]-s[0], h1=s[2]-s[1];
+    double duStart=-(2.0*h0+h1)/(h0*(h0+h1))*u[0]+(h0+h1)/(h0*h1)*u[1]-h0/(h1*(h0+h1))*u[2];
+    h0=s[m-1]-s[m-2];
+    h1=s[m-2]-s[m-3];
+    double duEnd=(2.0*h0+h1)/(h0*(h0+h1))*u[m-1]-(h0+h1)/(h0*h1)*u[m-2]+h0/(h1*(h0+h1))*u[m-3];
+
+    //clamped cubic spline second derivatives, tridiagonal solve
+    vector<double> d2(m), c(m);
+    double hl, hr, b;
+    hr=s[1]-s[0];
+    c[0]=0.5;
+    d2[0]=3.0*((u[1]-u[0])/hr-duStart)/hr;
+    for(int i=1; i<m; ++i){
+        hl=s[i]-s[i-1];
+        if(i<m-1){
+            hr=s[i+1]-s[i];
+            b=2.0*(hl+hr)-hl*c[i-1];
+            c[i]=hr/b;
+            d2[i]=(6.0*((u[i+1]-u[i])/hr-(u[i]-u[i-1])/hl)-hl*d2[i-1])/b;
+        }
+        else{
+            b=2.0*hl-hl*c[i-1];
+            c[i]=0.0;
+            d2[i]=(6.0*(duEnd-(u[i]-u[i-1])/hl)-hl*d2[i-1])/b;
+        }
+    }
+    for(int i=m-2; i>=0; --i) d2[i]-=c[i]*d2[i+1];
+
+    //evaluate spline and derivative on even grid
+    vector<double> uGrid(n+1), duGrid(n+1);
+    double h=(s[m-1]-s[0])/n;
+    int j=0;
+    for(int i=0; i<=n; ++i){
+        double x=(i==n) ? s[m-1] : s[0]+i*h;
+        while(j<m-2 && x>s[j+1]) ++j;
+        double hj=s[j+1]-s[j];
+        double a=(s[j+1]-x)/hj, b=(x-s[j])/hj;
+        uGrid[i]=a*u[j]+b*u[j+1]+((a*a*a-a)*d2[j]+(b*b*b-b)*d2[j+1])*hj*hj/6.0;
+        duGrid[i]=(u[j+1]-u[j])/hj+((1.0-3.0*a*a)*d2[j]+(3.0*b*b-1.0)*d2[j+1])*hj/6.0;
+    }
+    setHermite(s[0],s[m-1],uGrid,duGrid);
+    return true;
+}
+
+//##### LOOKUP #####
+template <typename T>
+inline bool PairTable<T>::empty() const {
+    //check if table set
+    return nIntervals==0;
+}
+
+template <typename T>
+inline void PairTable<T>::evaluate(T s, T &u, T &du) const {
+    //energy and derivative wrt s, constant cost, s must be below cutoff
+    T x=(s-s0)*invH;
+    if(x<0.0){
+        du=du0;
+        u=u0+du0*(s-s0);
+        return;
+    }
+    int i=x;
+    if(i>=nIntervals) i=nIntervals-1;
+    T t=x-i;
+    const T *c=&coeffs[4*i];
+    u=c[0]+t*(c[1]+t*(c[2]+t*c[3]));
+    du=(c[1]+t*(2*c[2]+3*t*c[3]))*invH;
+}
+
+template <typename T>
+inline T PairTable<T>::energy(T s) const {
+    //energy at squared separation
+    if(s>=sCut) return 0.0;
+    T x=(s-s0)*invH;
+    if(x<0.0) return u0+du0*(s-s0);
+    int i=x;
+    if(i>=nIntervals) i=nIntervals-1;
+    T t=x-i;
+    const T *c=&coeffs[4*i];
+    return c[0]+t*(c[1]+t*(c[2]+t*c[3]));
+}
+
+template <typename T>
+inline T PairTable<T>::forceFactor(T s) const {
+    //factor to multiply separation vector for force on second atom, -dU/dr/r=-2dU/ds
+    if(s>=sCut) return 0.0;
+    T u, du;
+    evaluate(s,u,du);
+    return -2*du;
+}
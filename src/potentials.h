@@ -1,96 +1,52 @@
-//Contains potential models.
+//Contains potential models, templated on dimension, floating point type and geometrical constraint.
 #ifndef MX2_POTENTIALS_H
 #define MX2_POTENTIALS_H
 
 #include <iostream>
 #include <cmath>
+#include <cassert>
 #include <limits>
+#include <array>
+#include <functional>
 #include "col_vector.h"
 #include "crd.h"
+#include "pairTable.h"
+#include "arena.h"
 
-struct BasePotentialCart2D{
-    //base struct for potential model in 2D cartesian coordinates
+const int maxInteractionTypes=4; //maximum size of type-indexed parameter tables
 
-    int nBonds, nAngles, nRep, nInterx; //number of bonds and angles and repulsions and intersections
-    col_vector<int> bonds; //list of bonds
-    col_vector<int> angles; //list of angles
-    col_vector<int> repulsions; //list of repulsions
-    col_vector<int> interx; //list of intersections
-    col_vector<int> fixed; //list of fixed atoms
-
-    //constructors
-    BasePotentialCart2D();
-    BasePotentialCart2D(vector<int> &bondsIn, vector<int> &anglesIn, vector<int> &repIn, vector<int> &fixedIn, vector<int> &interxIn);
-
-    //methods
-    void calculateForce(col_vector<double> &crds, col_vector<double> &force);
-    void calculateEnergy(col_vector<double> &crds, double &energy);
-
-    //virutal methods
-    virtual void bondForce(double &cx0, double &cy0, double &cx1, double &cy1,
-                           double &fx0, double &fy0, double &fx1, double &fy1, int paramRef)=0;
-    virtual void angleForce(double &cx0, double &cy0, double &cx1, double &cy1, double &cx2, double &cy2,
-                            double &fx0, double &fy0, double &fx1, double &fy1, double &fx2, double &fy2, int paramRef)=0;
-    virtual void repForce(double &cx0, double &cy0, double &cx1, double &cy1,
-                           double &fx0, double &fy0, double &fx1, double &fy1, int paramRef)=0;
-    virtual void bondEnergy(double &cx0, double &cy0, double &cx1, double &cy1, double &e, int paramRef)=0;
-    virtual void angleEnergy(double &cx0, double &cy0, double &cx1, double &cy1, double &cx2, double &cy2, double &e, int paramRef)=0;
-    virtual void repEnergy(double &cx0, double &cy0, double &cx1, double &cy1, double &e, int paramRef)=0;
-    virtual void interxEnergy(double &cx0, double &cy0, double &cx1, double &cy1, double &cx2, double &cy2, double &cx3, double &cy3, double &e)=0;
+//##### GEOMETRICAL CONSTRAINT POLICIES #####
+template <int D, typename T>
+struct NoConstraint{
+    //no geometrical constraint, constrained atoms ignored
+    void force(const array<T,D> &c, array<T,D> &f){f.fill(0.0);};
+    void energy(const array<T,D> &c, T &e){};
 };
 
-struct HC2: public BasePotentialCart2D{
-    //harmonic,cartesian, 2D
+template <int D, typename T>
+struct SphereConstraint{
+    //harmonic constraint of atoms to surface of sphere centred on origin
 
-    //potential information
-    col_vector<double> bondK, bondR0, angleK, angleR0; //constant and separation minimum
+    T k, r0; //constant and sphere radius
 
     //constructors
-    HC2();
-    HC2(vector<int> &bondsIn, vector<int> &anglesIn, vector<int> &repIn, double &bondKIn, double &bondR0In, double &angleKIn, double &angleR0In, vector<int> &fixedIn, vector<int> &interxIn);
-    HC2(vector<int> &bondsIn, vector<int> &anglesIn, vector<int> &repIn, vector<double> &bondKIn, vector<double> &bondR0In, vector<double> &angleKIn, vector<double> &angleR0In, vector<int> &fixedIn, vector<int> &interxIn);
+    SphereConstraint();
+    SphereConstraint(double kIn, double r0In);
 
-    //overrides for virtual methods
-    void bondForce(double &cx0, double &cy0, double &cx1, double &cy1,
-                   double &fx0, double &fy0, double &fx1, double &fy1, int paramRef) override;
-    void angleForce(double &cx0, double &cy0, double &cx1, double &cy1, double &cx2, double &cy2,
-                            double &fx0, double &fy0, double &fx1, double &fy1, double &fx2, double &fy2, int paramRef) override;;
-    void repForce(double &cx0, double &cy0, double &cx1, double &cy1,
-                          double &fx0, double &fy0, double &fx1, double &fy1, int paramRef) override;;
-    void bondEnergy(double &cx0, double &cy0, double &cx1, double &cy1, double &e, int paramRef) override;
-    void angleEnergy(double &cx0, double &cy0, double &cx1, double &cy1, double &cx2, double &cy2, double &e, int paramRef) override;
-    void repEnergy(double &cx0, double &cy0, double &cx1, double &cy1, double &e, int paramRef) override;
-    void interxEnergy(double &cx0, double &cy0, double &cx1, double &cy1, double &cx2, double &cy2, double &cx3, double &cy3, double &e) override;
+    //methods
+    void force(const array<T,D> &c, array<T,D> &f);
+    void energy(const array<T,D> &c, T &e);
 };
 
-struct HLJC2: public BasePotentialCart2D{
-    //harmonic,cartesian, 2D
-
-    //potential information
-    col_vector<double> bondK, bondR0, repEpsilon, repR02; //constant and separation minimum
-
-    //constructors
-    HLJC2();
-    HLJC2(vector<int> &bondsIn, vector<int> &anglesIn, vector<int> &repIn, double &bondKIn, double &bondR0In, double &repEpIn, double &repR0In, vector<int> &fixedIn, vector<int> &interxIn);
-    HLJC2(vector<int> &bondsIn, vector<int> &anglesIn, vector<int> &repIn, vector<double> &bondKIn, vector<double> &bondR0In, vector<double> &repEpIn, vector<double> &repR0In, vector<int> &fixedIn, vector<int> &interxIn);
-
-    //overrides for virtual methods
-    void bondForce(double &cx0, double &cy0, double &cx1, double &cy1,
-                   double &fx0, double &fy0, double &fx1, double &fy1, int paramRef) override;
-    void angleForce(double &cx0, double &cy0, double &cx1, double &cy1, double &cx2, double &cy2,
-                            double &fx0, double &fy0, double &fx1, double &fy1, double &fx2, double &fy2, int paramRef) override;;
-    void repForce(double &cx0, double &cy0, double &cx1, double &cy1,
-                          double &fx0, double &fy0, double &fx1, double &fy1, int paramRef) override;;
-    void bondEnergy(double &cx0, double &cy0, double &cx1, double &cy1, double &e, int paramRef) override;
-    void angleEnergy(double &cx0, double &cy0, double &cx1, double &cy1, double &cx2, double &cy2, double &e, int paramRef) override;
-    void repEnergy(double &cx0, double &cy0, double &cx1, double &cy1, double &e, int paramRef) override;
-    void interxEnergy(double &cx0, double &cy0, double &cx1, double &cy1, double &cx2, double &cy2, double &cx3, double &cy3, double &e) override;
-};
+//##### POTENTIAL MODELS #####
+template <int D, typename T=double>
+struct BasePotentialCart{
+    //base struct for potential model in D dimensional cartesian coordinates
 
-struct BasePotentialCart3D{
-    //base struct for potential model in 3D cartesian coordinates, with potential for geometrical constraint
+    typedef T Scalar; //floating point type of coordinates, forces and energies
+    typedef array<T,D> Vec; //position or force of single atom
 
-    int nBonds, nAngles, nRep, nInterx; //number of bonds and angles, intersections
+    int nBonds, nAngles, nRep, nInterx; //number of bonds and angles and repulsions and intersections
     col_vector<int> bonds; //list of bonds
     col_vector<int> angles; //list of angles
     col_vector<int> repulsions; //list of repulsions
@@ -99,85 +55,141 @@ struct BasePotentialCart3D{
     col_vector<int> constrained; //list of constrained atoms
 
     //constructors
-    BasePotentialCart3D();
-    BasePotentialCart3D(vector<int> &bondsIn, vector<int> &anglesIn, vector<int> &repIn, vector<int> &fixedIn, vector<int> &interxIn, vector<int> &constrainedIn);
+    BasePotentialCart();
+    BasePotentialCart(const ArenaVector<int> &bondsIn, const ArenaVector<int> &anglesIn, const ArenaVector<int> &repIn, const ArenaVector<int> &fixedIn, const ArenaVector<int> &interxIn, const ArenaVector<int> &constrainedIn);
+
+    //parallel evaluation
+    int nThreads; //number of threads, interactions split into this many contiguous chunks
+    vector< col_vector<T> > chunkForces; //force buffer for each chunk, reduced in chunk order
+    vector<T> chunkEnergies; //energy of each chunk, summed in chunk order
+
+    //repulsion neighbour list, regenerated when any atom moves over half the skin since last build
+    function<void(col_vector<T>&,ArenaVector<int>&)> neighbourUpdate; //regenerate repulsions from coordinates, unset for fixed list
+    ArenaVector<int> neighbourList; //rebuilt repulsions, storage reused between rebuilds
+    col_vector<T> neighbourCrds; //coordinates at last build
+    T halfSkinSq; //squared displacement triggering rebuild
 
     //methods
-    void calculateForce(col_vector<double> &crds, col_vector<double> &force);
-    void calculateEnergy(col_vector<double> &crds, double &energy);
+    void setThreads(int n);
+    void setNeighbourUpdate(function<void(col_vector<T>&,ArenaVector<int>&)> update, double halfSkin, col_vector<T> &crds);
+    void checkNeighbours(col_vector<T> &crds);
+    void calculateForce(col_vector<T> &crds, col_vector<T> &force);
+    void calculateEnergy(col_vector<T> &crds, T &energy);
+    void chunkForce(col_vector<T> &crds, col_vector<T> &force, int chunk, int nChunks);
+    void chunkEnergy(col_vector<T> &crds, T &energy, int chunk, int nChunks);
+    static void getCrd(col_vector<T> &crds, int atom, Vec &c);
+    static void addForce(col_vector<T> &force, int atom, Vec &f);
+
+    //interaction loops over range - virtual so derived models can provide specialised kernels
+    virtual void constraintForces(col_vector<T> &crds, col_vector<T> &force, int begin, int end);
+    virtual void constraintEnergies(col_vector<T> &crds, T &energy, int begin, int end);
+    virtual void bondForces(col_vector<T> &crds, col_vector<T> &force, int begin, int end);
+    virtual void bondEnergies(col_vector<T> &crds, T &energy, int begin, int end);
+    virtual void repForces(col_vector<T> &crds, col_vector<T> &force, int begin, int end);
+    virtual void repEnergies(col_vector<T> &crds, T &energy, int begin, int end);
 
     //virutal methods
-    virtual void constraintForce(double &cx0, double &cy0, double &cz0,
-                                 double &fx0, double &fy0, double &fz0, int paramRef)=0;
-    virtual void bondForce(double &cx0, double &cy0, double &cz0, double &cx1, double &cy1, double &cz1,
-                           double &fx0, double &fy0, double &fz0, double &fx1, double &fy1, double &fz1, int paramRef)=0;
-    virtual void angleForce(double &cx0, double &cy0, double &cz0, double &cx1, double &cy1, double &cz1, double &cx2, double &cy2, double &cz2,
-                            double &fx0, double &fy0, double &fz0, double &fx1, double &fy1, double &fz1, double &fx2, double &fy2, double &fz2, int paramRef)=0;
-    virtual void repForce(double &cx0, double &cy0, double &cz0, double &cx1, double &cy1, double &cz1,
-                           double &fx0, double &fy0, double &fz0, double &fx1, double &fy1, double &fz1, int paramRef)=0;
-    virtual void constraintEnergy(double &cx0, double &cy0, double &cz0, double &e, int paramRef)=0;
-    virtual void bondEnergy(double &cx0, double &cy0, double &cz0, double &cx1, double &cy1, double &cz1, double &e, int paramRef)=0;
-    virtual void angleEnergy(double &cx0, double &cy0, double &cz0, double &cx1, double &cy1, double &cz1, double &cx2, double &cy2, double &cz2, double &e, int paramRef)=0;
-    virtual void repEnergy(double &cx0, double &cy0, double &cz0, double &cx1, double &cy1, double &cz1, double &e, int paramRef)=0;
-    virtual void interxEnergy(double &cx0, double &cy0, double &cz0, double &cx1, double &cy1, double &cz1, double &cx2, double &cy2, double &cz2, double &cx3, double &cy3, double &cz3, double &e)=0;
+    virtual void bondForce(const Vec &c0, const Vec &c1, Vec &f0, Vec &f1, int paramRef)=0;
+    virtual void angleForce(const Vec &c0, const Vec &c1, const Vec &c2, Vec &f0, Vec &f1, Vec &f2, int paramRef)=0;
+    virtual void repForce(const Vec &c0, const Vec &c1, Vec &f0, Vec &f1, int paramRef)=0;
+    virtual void bondEnergy(const Vec &c0, const Vec &c1, T &e, int paramRef)=0;
+    virtual void angleEnergy(const Vec &c0, const Vec &c1, const Vec &c2, T &e, int paramRef)=0;
+    virtual void repEnergy(const Vec &c0, const Vec &c1, T &e, int paramRef)=0;
+    virtual void interxEnergy(const Vec &c0, const Vec &c1, const Vec &c2, const Vec &c3, T &e)=0;
+    virtual void interxForce(const Vec &c0, const Vec &c1, const Vec &c2, const Vec &c3, Vec &f0, Vec &f1, Vec &f2, Vec &f3)=0;
 };
 
-struct HC3S: public BasePotentialCart3D{
-    //harmonic, cartesian, 3D, sphere constrained
+template <int D, typename T=double, typename Constraint=NoConstraint<D,T> >
+struct HC: public BasePotentialCart<D,T>{
+    //harmonic, cartesian, angles as 1-3 harmonic bonds
+
+    typedef array<T,D> Vec;
 
     //potential information
-    col_vector<double> bondK, bondR0, angleK, angleR0, constraintR0, constraintK; //constant and separation minimum
+    col_vector<T> bondK, bondR0, angleK, angleR0; //constant and separation minimum
+    Constraint constraint; //geometrical constraint
 
     //constructors
-    HC3S();
-    HC3S(vector<int> &bondsIn, vector<int> &anglesIn, vector<int> &repIn, vector<int> &fixedIn, vector<int> &interxIn, vector<int> constrIn,
-         double &bondKIn, double &bondR0In, double &angleKIn, double &angleR0In, double &constrKIn, double &constrR0In);
-    HC3S(vector<int> &bondsIn, vector<int> &anglesIn, vector<int> &repIn, vector<int> &fixedIn, vector<int> &interxIn, vector<int> constrIn,
-         vector<double> &bondKIn, vector<double> &bondR0In, vector<double> &angleKIn, vector<double> &angleR0In, vector<double> &constrKIn, vector<double> &constrR0In);
+    HC();
+    HC(const ArenaVector<int> &bondsIn, const ArenaVector<int> &anglesIn, const ArenaVector<int> &repIn, const ArenaVector<int> &fixedIn, const ArenaVector<int> &interxIn,
+       double bondKIn, double bondR0In, double angleKIn, double angleR0In,
+       const ArenaVector<int> &constrIn=ArenaVector<int>(), const Constraint &constraintIn=Constraint());
+    HC(const ArenaVector<int> &bondsIn, const ArenaVector<int> &anglesIn, const ArenaVector<int> &repIn, const ArenaVector<int> &fixedIn, const ArenaVector<int> &interxIn,
+       const ArenaVector<double> &bondKIn, const ArenaVector<double> &bondR0In, const ArenaVector<double> &angleKIn, const ArenaVector<double> &angleR0In,
+       const ArenaVector<int> &constrIn=ArenaVector<int>(), const Constraint &constraintIn=Constraint());
 
     //overrides for virtual methods
-    void constraintForce(double &cx0, double &cy0, double &cz0,
-                                 double &fx0, double &fy0, double &fz0, int paramRef) override;
-    void bondForce(double &cx0, double &cy0, double &cz0, double &cx1, double &cy1, double &cz1,
-                           double &fx0, double &fy0, double &fz0, double &fx1, double &fy1, double &fz1, int paramRef) override;
-    void angleForce(double &cx0, double &cy0, double &cz0, double &cx1, double &cy1, double &cz1, double &cx2, double &cy2, double &cz2,
-                            double &fx0, double &fy0, double &fz0, double &fx1, double &fy1, double &fz1, double &fx2, double &fy2, double &fz2, int paramRef) override;
-    void repForce(double &cx0, double &cy0, double &cz0, double &cx1, double &cy1, double &cz1,
-                   double &fx0, double &fy0, double &fz0, double &fx1, double &fy1, double &fz1, int paramRef) override;
-    void constraintEnergy(double &cx0, double &cy0, double &cz0, double &e, int paramRef) override;
-    void bondEnergy(double &cx0, double &cy0, double &cz0, double &cx1, double &cy1, double &cz1, double &e, int paramRef) override;
-    void angleEnergy(double &cx0, double &cy0, double &cz0, double &cx1, double &cy1, double &cz1, double &cx2, double &cy2, double &cz2, double &e, int paramRef) override;
-    void repEnergy(double &cx0, double &cy0, double &cz0, double &cx1, double &cy1, double &cz1, double &e, int paramRef) override;
-    void interxEnergy(double &cx0, double &cy0, double &cz0, double &cx1, double &cy1, double &cz1, double &cx2, double &cy2, double &cz2, double &cx3, double &cy3, double &cz3, double &e) override;
+    void constraintForces(col_vector<T> &crds, col_vector<T> &force, int begin, int end) override;
+    void constraintEnergies(col_vector<T> &crds, T &energy, int begin, int end) override;
+    void bondForce(const Vec &c0, const Vec &c1, Vec &f0, Vec &f1, int paramRef) override;
+    void angleForce(const Vec &c0, const Vec &c1, const Vec &c2, Vec &f0, Vec &f1, Vec &f2, int paramRef) override;
+    void repForce(const Vec &c0, const Vec &c1, Vec &f0, Vec &f1, int paramRef) override;
+    void bondEnergy(const Vec &c0, const Vec &c1, T &e, int paramRef) override;
+    void angleEnergy(const Vec &c0, const Vec &c1, const Vec &c2, T &e, int paramRef) override;
+    void repEnergy(const Vec &c0, const Vec &c1, T &e, int paramRef) override;
+    void interxEnergy(const Vec &c0, const Vec &c1, const Vec &c2, const Vec &c3, T &e) override;
+    void interxForce(const Vec &c0, const Vec &c1, const Vec &c2, const Vec &c3, Vec &f0, Vec &f1, Vec &f2, Vec &f3) override;
 };
 
-struct HLJC3S: public BasePotentialCart3D{
-    //harmonic with LJ repulsions, cartesian, 3D, sphere constrained
+template <int D, typename T=double, typename Constraint=NoConstraint<D,T> >
+struct HLJC: public BasePotentialCart<D,T>{
+    //harmonic with LJ repulsions, cartesian
 
-    //potential information
-    col_vector<double> bondK, bondR0, repEpsilon, repR02, constraintR0, constraintK; //constant and separation minimum
+    typedef array<T,D> Vec;
+
+    //potential information, bond parameters held in table indexed by interaction type
+    int nBondTypes; //number of bond types
+    col_vector<unsigned char> bondTypes; //type code of each bond
+    T bondK[maxInteractionTypes], bondR0[maxInteractionTypes]; //constant and separation minimum for each bond type
+    T repEpsilon, repR02; //single set of LJ parameters
+    const PairTable<T> *repTable; //tabulated repulsion, analytic LJ if null
+    T interxK; //constant of soft penalty on intersecting edges, zero for none
+    Constraint constraint; //geometrical constraint
 
     //constructors
-    HLJC3S();
-    HLJC3S(vector<int> &bondsIn, vector<int> &anglesIn, vector<int> &repIn, vector<int> &fixedIn, vector<int> &interxIn, vector<int> constrIn,
-    double &bondKIn, double &bondR0In, double &repEpIn, double &repR0In, double &constrKIn, double &constrR0In);
-    HLJC3S(vector<int> &bondsIn, vector<int> &anglesIn, vector<int> &repIn, vector<int> &fixedIn, vector<int> &interxIn, vector<int> constrIn,
-    vector<double> &bondKIn, vector<double> &bondR0In, vector<double> &repEpIn, vector<double> &repR0In, vector<double> &constrKIn, vector<double> &constrR0In);
+    HLJC();
+    HLJC(const ArenaVector<int> &bondsIn, const ArenaVector<int> &anglesIn, const ArenaVector<int> &repIn, const ArenaVector<int> &fixedIn, const ArenaVector<int> &interxIn,
+         double bondKIn, double bondR0In, double repEpIn, double repR0In,
+         const ArenaVector<int> &constrIn=ArenaVector<int>(), const Constraint &constraintIn=Constraint());
+    HLJC(const ArenaVector<int> &bondsIn, const ArenaVector<int> &anglesIn, const ArenaVector<int> &repIn, const ArenaVector<int> &fixedIn, const ArenaVector<int> &interxIn,
+         const ArenaVector<int> &bondTypesIn, const ArenaVector<double> &bondKIn, const ArenaVector<double> &bondR0In, double repEpIn, double repR0In,
+         const ArenaVector<int> &constrIn=ArenaVector<int>(), const Constraint &constraintIn=Constraint());
+
+    //methods
+    void setRepulsionTable(const PairTable<T> *table);
+    void setIntersectionPenalty(double k);
+
+    //kernels for all interactions of a kind, bonds without parameter loads if single bond type
+    void constraintForces(col_vector<T> &crds, col_vector<T> &force, int begin, int end) override;
+    void constraintEnergies(col_vector<T> &crds, T &energy, int begin, int end) override;
+    void bondForces(col_vector<T> &crds, col_vector<T> &force, int begin, int end) override;
+    void bondEnergies(col_vector<T> &crds, T &energy, int begin, int end) override;
+    void repForces(col_vector<T> &crds, col_vector<T> &force, int begin, int end) override;
+    void repEnergies(col_vector<T> &crds, T &energy, int begin, int end) override;
+    template <bool singleType> void harmonicBondForces(col_vector<T> &crds, col_vector<T> &force, int begin, int end);
+    template <bool singleType> void harmonicBondEnergies(col_vector<T> &crds, T &energy, int begin, int end);
+    void ljRepForces(col_vector<T> &crds, col_vector<T> &force, int begin, int end);
+    void ljRepEnergies(col_vector<T> &crds, T &energy, int begin, int end);
+    void tableRepForces(col_vector<T> &crds, col_vector<T> &force, int begin, int end);
+    void tableRepEnergies(col_vector<T> &crds, T &energy, int begin, int end);
 
     //overrides for virtual methods
-    void constraintForce(double &cx0, double &cy0, double &cz0,
-                         double &fx0, double &fy0, double &fz0, int paramRef) override;
-    void bondForce(double &cx0, double &cy0, double &cz0, double &cx1, double &cy1, double &cz1,
-                   double &fx0, double &fy0, double &fz0, double &fx1, double &fy1, double &fz1, int paramRef) override;
-    void angleForce(double &cx0, double &cy0, double &cz0, double &cx1, double &cy1, double &cz1, double &cx2, double &cy2, double &cz2,
-                    double &fx0, double &fy0, double &fz0, double &fx1, double &fy1, double &fz1, double &fx2, double &fy2, double &fz2, int paramRef) override;
-    void repForce(double &cx0, double &cy0, double &cz0, double &cx1, double &cy1, double &cz1,
-                  double &fx0, double &fy0, double &fz0, double &fx1, double &fy1, double &fz1, int paramRef) override;
-    void constraintEnergy(double &cx0, double &cy0, double &cz0, double &e, int paramRef) override;
-    void bondEnergy(double &cx0, double &cy0, double &cz0, double &cx1, double &cy1, double &cz1, double &e, int paramRef) override;
-    void angleEnergy(double &cx0, double &cy0, double &cz0, double &cx1, double &cy1, double &cz1, double &cx2, double &cy2, double &cz2, double &e, int paramRef) override;
-    void repEnergy(double &cx0, double &cy0, double &cz0, double &cx1, double &cy1, double &cz1, double &e, int paramRef) override;
-    void interxEnergy(double &cx0, double &cy0, double &cz0, double &cx1, double &cy1, double &cz1, double &cx2, double &cy2, double &cz2, double &cx3, double &cy3, double &cz3, double &e) override;
+    void bondForce(const Vec &c0, const Vec &c1, Vec &f0, Vec &f1, int paramRef) override;
+    void angleForce(const Vec &c0, const Vec &c1, const Vec &c2, Vec &f0, Vec &f1, Vec &f2, int paramRef) override;
+    void repForce(const Vec &c0, const Vec &c1, Vec &f0, Vec &f1, int paramRef) override;
+    void bondEnergy(const Vec &c0, const Vec &c1, T &e, int paramRef) override;
+    void angleEnergy(const Vec &c0, const Vec &c1, const Vec &c2, T &e, int paramRef) override;
+    void repEnergy(const Vec &c0, const Vec &c1, T &e, int paramRef) override;
+    void interxEnergy(const Vec &c0, const Vec &c1, const Vec &c2, const Vec &c3, T &e) override;
+    void interxForce(const Vec &c0, const Vec &c1, const Vec &c2, const Vec &c3, Vec &f0, Vec &f1, Vec &f2, Vec &f3) override;
 };
 
+//models used by networks
+template <typename T=double> using HC2=HC<2,T>; //2D
+template <typename T=double> using HC3S=HC<3,T,SphereConstraint<3,T> >; //3D sphere constrained
+template <typename T=double> using HLJC2=HLJC<2,T>; //2D
+template <typename T=double> using HLJC3S=HLJC<3,T,SphereConstraint<3,T> >; //3D sphere constrained
+
+#include "potentials.tpp"
+
 #endif //MX2_POTENTIALS_H
@@ -0,0 +1,905 @@
+#include "potentials.h"
+
+//##### INTERACTION LISTS #####
+template <typename T>
+col_vector<T> listView(const ArenaVector<T> &list) {
+    //view of interaction list without copying, never written through
+    return col_vector<T>(const_cast<T*>(list.data()),list.size());
+}
+
+//##### PARAMETER TABLES #####
+template <typename T>
+void setBondTypes(const ArenaVector<int> &typesIn, const ArenaVector<double> &kIn, const ArenaVector<double> &r0In, int &nTypes,
+                  col_vector<unsigned char> &types, T *k, T *r0) {
+    //fill bond parameter table, merging types with identical parameters so single type case can be detected
+    //tables and type codes built by network from its own bond types, so inconsistency is programming error
+    assert(kIn.size()<=maxInteractionTypes && r0In.size()==kIn.size());
+    int typeMap[maxInteractionTypes];
+    nTypes=0;
+    for(int i=0; i<kIn.size(); ++i){
+        typeMap[i]=nTypes;
+        for(int j=0; j<nTypes; ++j){
+            if(k[j]==T(kIn[i]) && r0[j]==T(r0In[i])){
+                typeMap[i]=j;
+                break;
+            }
+        }
+        if(typeMap[i]==nTypes){
+            k[nTypes]=kIn[i];
+            r0[nTypes]=r0In[i];
+            ++nTypes;
+        }
+    }
+    Arena *arena=typesIn.get_allocator().arena; //table drawn from same arena as type codes, heap if none
+    if(arena==nullptr) types=col_vector<unsigned char>(typesIn.size());
+    else{
+        col_vector<unsigned char> table(arena->allocate<unsigned char>(typesIn.size()),typesIn.size());
+        types.swap(table);
+    }
+    for(int i=0; i<typesIn.size(); ++i){
+        assert(typesIn[i]>=0 && typesIn[i]<kIn.size());
+        types[i]=typeMap[typesIn[i]];
+    }
+}
+
+//##### VECTOR MATHS #####
+template <int D, typename T>
+inline T separationSq(const array<T,D> &c0, const array<T,D> &c1, array<T,D> &dx) {
+    //vector from c0 to c1 and its squared length
+    dx[0]=c1[0]-c0[0];
+    T r2=dx[0]*dx[0];
+    for(int d=1; d<D; ++d){
+        dx[d]=c1[d]-c0[d];
+        r2+=dx[d]*dx[d];
+    }
+    return r2;
+}
+
+template <int D, typename T>
+inline T separationSq(col_vector<T> &crds, int x0, int x1, array<T,D> &dx) {
+    //vector between atoms starting at given coordinate indices and its squared length
+    dx[0]=crds[x1]-crds[x0];
+    T r2=dx[0]*dx[0];
+    for(int d=1; d<D; ++d){
+        dx[d]=crds[x1+d]-crds[x0+d];
+        r2+=dx[d]*dx[d];
+    }
+    return r2;
+}
+
+template <typename T>
+inline bool properIntersection(const array<T,2> &c0, const array<T,2> &c1, const array<T,2> &c2, const array<T,2> &c3) {
+    //proper intersection of line segments c0-c1 and c2-c3
+    double x0=c0[0], y0=c0[1], x1=c1[0], y1=c1[1], x2=c2[0], y2=c2[1], x3=c3[0], y3=c3[1];
+    return properIntersectionLines(x0,y0,x1,y1,x2,y2,x3,y3);
+}
+
+template <typename T>
+inline array<T,3> cross(const array<T,3> &a, const array<T,3> &b) {
+    //vector product axb
+    return {a[1]*b[2]-a[2]*b[1],a[2]*b[0]-a[0]*b[2],a[0]*b[1]-a[1]*b[0]};
+}
+
+template <typename T>
+inline bool properIntersection(const array<T,3> &c0, const array<T,3> &c1, const array<T,3> &c2, const array<T,3> &c3) {
+    //proper intersection of great circle arcs c0-c1 and c2-c3 on sphere centred at origin
+    //most pairs in list far apart, so first rejected if c2 and c3 on same side of plane of c0-c1, sign unchanged by projection
+    array<T,3> n=cross(c0,c1);
+    T s0=n[0]*c2[0]+n[1]*c2[1]+n[2]*c2[2], s1=n[0]*c3[0]+n[1]*c3[1]+n[2]*c3[2];
+    if((s0>0.0)==(s1>0.0)) return false;
+    return properIntersectionArcs(Cart3D(c0[0],c0[1],c0[2]),Cart3D(c1[0],c1[1],c1[2]),Cart3D(c2[0],c2[1],c2[2]),Cart3D(c3[0],c3[1],c3[2]));
+}
+
+template <typename T>
+inline void intersectionPenalty(const array<T,2> &c0, const array<T,2> &c1, const array<T,2> &c2, const array<T,2> &c3, T k, T &e, array<T,2> *f) {
+    //penalty for properly intersecting segments c0-c1 and c2-c3, U=0.5k*d^2 where d is distance of shallowest end point to line of other segment
+    //end point p and line u-v give d^2=s^2/q, with s signed parallelogram area and q squared length of line segment
+    //forces added to f if not null, most pairs in list far apart so rejected on bounding boxes first
+    for(int d=0; d<2; ++d){
+        if(max(c0[d],c1[d])<min(c2[d],c3[d]) || max(c2[d],c3[d])<min(c0[d],c1[d])) return;
+    }
+    if(!properIntersection(c0,c1,c2,c3)) return;
+    const array<T,2> *c[4]={&c0,&c1,&c2,&c3};
+    const int ends[4][3]={{2,0,1},{3,0,1},{0,2,3},{1,2,3}};
+    int best=0;
+    T bestS=0.0, bestQ=1.0, bestD2=numeric_limits<T>::infinity();
+    for(int i=0; i<4; ++i){
+        const array<T,2> &p=*c[ends[i][0]], &u=*c[ends[i][1]], &v=*c[ends[i][2]];
+        T ex=v[0]-u[0], ey=v[1]-u[1], wx=p[0]-u[0], wy=p[1]-u[1];
+        T s=ex*wy-ey*wx, q=ex*ex+ey*ey;
+        T d2=s*s/q;
+        if(d2<bestD2){
+            best=i;
+            bestS=s;
+            bestQ=q;
+            bestD2=d2;
+        }
+    }
+    e+=0.5*k*bestD2;
+    if(f==nullptr) return;
+
+    //force as negative gradient of 0.5k*s^2/q with respect to p, u and v
+    int ip=ends[best][0], iu=ends[best][1], iv=ends[best][2];
+    const array<T,2> &p=*c[ip], &u=*c[iu], &v=*c[iv];
+    T ex=v[0]-u[0], ey=v[1]-u[1], wx=p[0]-u[0], wy=p[1]-u[1];
+    T a=k*bestS/bestQ, b=k*bestD2/bestQ;
+    f[ip][0]+=a*ey;
+    f[ip][1]-=a*ex;
+    f[iu][0]-=a*(ey-wy)+b*ex;
+    f[iu][1]-=a*(wx-ex)+b*ey;
+    f[iv][0]-=a*wy-b*ex;
+    f[iv][1]+=a*wx+b*ey;
+}
+
+template <typename T>
+inline void intersectionPenalty(const array<T,3> &c0, const array<T,3> &c1, const array<T,3> &c2, const array<T,3> &c3, T k, T &e, array<T,3> *f) {
+    //penalty for properly intersecting arcs c0-c1 and c2-c3, U=0.5k*d^2 where d is distance of shallowest end point to plane of other arc
+    //end point p and arc u-v give d^2=s^2/q, with s=p.(uxv) and q squared length of normal uxv, as 2D case with lines through origin
+    if(!properIntersection(c0,c1,c2,c3)) return;
+    const array<T,3> *c[4]={&c0,&c1,&c2,&c3};
+    const int ends[4][3]={{2,0,1},{3,0,1},{0,2,3},{1,2,3}};
+    int best=0;
+    T bestS=0.0, bestQ=1.0, bestD2=numeric_limits<T>::infinity();
+    for(int i=0; i<4; ++i){
+        const array<T,3> &p=*c[ends[i][0]];
+        array<T,3> n=cross(*c[ends[i][1]],*c[ends[i][2]]);
+        T s=p[0]*n[0]+p[1]*n[1]+p[2]*n[2], q=n[0]*n[0]+n[1]*n[1]+n[2]*n[2];
+        T d2=s*s/q;
+        if(d2<bestD2){
+            best=i;
+            bestS=s;
+            bestQ=q;
+            bestD2=d2;
+        }
+    }
+    e+=0.5*k*bestD2;
+    if(f==nullptr) return;
+
+    //force as negative gradient of 0.5k*s^2/q, using ds/du=vxp, ds/dv=pxu, dq/du=2vxn and dq/dv=2nxu
+    int ip=ends[best][0], iu=ends[best][1], iv=ends[best][2];
+    const array<T,3> &p=*c[ip], &u=*c[iu], &v=*c[iv];
+    array<T,3> n=cross(u,v), vp=cross(v,p), pu=cross(p,u), vn=cross(v,n), nu=cross(n,u);
+    T a=k*bestS/bestQ, b=k*bestD2/bestQ;
+    for(int d=0; d<3; ++d){
+        f[ip][d]-=a*n[d];
+        f[iu][d]-=a*vp[d]-b*vn[d];
+        f[iv][d]-=a*pu[d]-b*nu[d];
+    }
+}
+
+//##### SPHERE CONSTRAINT #####
+template <int D, typename T>
+SphereConstraint<D,T>::SphereConstraint(){
+    //default constructor
+    k=0.0;
+    r0=1.0;
+}
+
+template <int D, typename T>
+SphereConstraint<D,T>::SphereConstraint(double kIn, double r0In){
+    //construct with constant and sphere radius
+    k=kIn;
+    r0=r0In;
+}
+
+template <int D, typename T>
+inline void SphereConstraint<D,T>::force(const array<T,D> &c, array<T,D> &f) {
+    //calculate force from point to constraining sphere, f=-k(r-r0)
+    array<T,D> origin{};
+    T r=sqrt(separationSq<D,T>(origin,c,f));
+    T mag=-k*(r-r0)/r;
+    for(int d=0; d<D; ++d) f[d]*=mag;
+}
+
+template <int D, typename T>
+inline void SphereConstraint<D,T>::energy(const array<T,D> &c, T &e) {
+    //calculate energy from point to constraining sphere, U=0.5k(r-r0)^2
+    T r2=c[0]*c[0];
+    for(int d=1; d<D; ++d) r2+=c[d]*c[d];
+    T r=sqrt(r2);
+    e+=0.5*k*pow((r-r0),2);
+}
+
+//##### BASE POTENTIAL MODEL IN CARTESIAN COORDINATES #####
+template <int D, typename T>
+BasePotentialCart<D,T>::BasePotentialCart(){
+    //default constructor
+    nThreads=1;
+    halfSkinSq=0.0;
+}
+
+template <int D, typename T>
+BasePotentialCart<D,T>::BasePotentialCart(const ArenaVector<int> &bondsIn, const ArenaVector<int> &anglesIn, const ArenaVector<int> &repIn, const ArenaVector<int> &fixedIn,
+                                          const ArenaVector<int> &interxIn, const ArenaVector<int> &constrainedIn):
+                                          bonds(listView(bondsIn)), angles(listView(anglesIn)), repulsions(listView(repIn)), interx(listView(interxIn)),
+                                          fixed(listView(fixedIn)), constrained(listView(constrainedIn)) {
+    //interaction lists are read only views of given lists, which must outlive model
+    nBonds=bonds.n/2;
+    nAngles=angles.n/3;
+    nRep=repulsions.n/2;
+    nInterx=interx.n/4;
+    nThreads=1;
+    halfSkinSq=0.0;
+}
+
+template <int D, typename T>
+void BasePotentialCart<D,T>::setThreads(int n) {
+    //set number of threads for force and energy evaluation
+    nThreads=max(n,1);
+}
+
+template <int D, typename T>
+void BasePotentialCart<D,T>::setNeighbourUpdate(function<void(col_vector<T>&,ArenaVector<int>&)> update, double halfSkin, col_vector<T> &crds) {
+    //treat repulsions as neighbour list built at given coordinates, regenerated through update when stale
+    neighbourUpdate=update;
+    halfSkinSq=halfSkin*halfSkin;
+    neighbourCrds=crds;
+}
+
+template <int D, typename T>
+void BasePotentialCart<D,T>::checkNeighbours(col_vector<T> &crds) {
+    //rebuild repulsions if any atom has moved over half the skin, so no pair beyond list can be within cutoff
+    Vec c0, c1;
+    bool stale=false;
+    for(int i=0, n=crds.n/D; i<n && !stale; ++i){
+        getCrd(crds,i,c0);
+        getCrd(neighbourCrds,i,c1);
+        T dSq=0.0;
+        for(int d=0; d<D; ++d) dSq+=(c0[d]-c1[d])*(c0[d]-c1[d]);
+        stale=dSq>halfSkinSq;
+    }
+    if(!stale) return;
+    neighbourList.clear();
+    neighbourUpdate(crds,neighbourList);
+    col_vector<int> updated=listView(neighbourList); //view of rebuilt list, replaces view of original list
+    repulsions.swap(updated);
+    nRep=repulsions.n/2;
+    neighbourCrds=crds;
+}
+
+template <int D, typename T>
+inline void BasePotentialCart<D,T>::getCrd(col_vector<T> &crds, int atom, Vec &c) {
+    //get coordinates of single atom
+    for(int d=0; d<D; ++d) c[d]=crds[D*atom+d];
+}
+
+template <int D, typename T>
+inline void BasePotentialCart<D,T>::addForce(col_vector<T> &force, int atom, Vec &f) {
+    //add force on single atom
+    for(int d=0; d<D; ++d) force[D*atom+d]+=f[d];
+}
+
+template <int D, typename T>
+void BasePotentialCart<D,T>::calculateForce(col_vector<T> &crds, col_vector<T> &force) {
+    //calculate force from all interactions
+
+    //refresh neighbour list if atoms moved over half skin since last built
+    if(neighbourUpdate) checkNeighbours(crds);
+
+    //serial evaluation
+    if(nThreads==1){
+        chunkForce(crds,force,0,1);
+        return;
+    }
+
+    //evaluate each chunk of interactions into own buffer
+    if(chunkForces.size()!=nThreads || chunkForces[0].n!=force.n) chunkForces.assign(nThreads,col_vector<T>(force.n));
+    #pragma omp parallel for num_threads(nThreads) schedule(static,1)
+    for(int c=0; c<nThreads; ++c) chunkForce(crds,chunkForces[c],c,nThreads);
+
+    //reduce buffers in fixed chunk order so result independent of thread scheduling
+    #pragma omp parallel for num_threads(nThreads) schedule(static)
+    for(int i=0; i<force.n; ++i){
+        T f=chunkForces[0][i];
+        for(int c=1; c<nThreads; ++c) f+=chunkForces[c][i];
+        force[i]=f;
+    }
+}
+
+template <int D, typename T>
+void BasePotentialCart<D,T>::calculateEnergy(col_vector<T> &crds, T &energy) {
+    //calculate energy from all interactions
+
+    //line search trial coordinates can move further than accepted steps, so refresh neighbour list here too
+    if(neighbourUpdate) checkNeighbours(crds);
+
+    //serial evaluation
+    if(nThreads==1){
+        chunkEnergy(crds,energy,0,1);
+        return;
+    }
+
+    //evaluate each chunk of interactions separately and sum in fixed chunk order
+    chunkEnergies.resize(nThreads);
+    #pragma omp parallel for num_threads(nThreads) schedule(static,1)
+    for(int c=0; c<nThreads; ++c) chunkEnergy(crds,chunkEnergies[c],c,nThreads);
+    energy=0.0;
+    for(int c=0; c<nThreads; ++c) energy+=chunkEnergies[c];
+}
+
+template <int D, typename T>
+void BasePotentialCart<D,T>::chunkForce(col_vector<T> &crds, col_vector<T> &force, int chunk, int nChunks) {
+    //calculate force from contiguous chunk of each interaction list
+
+    //reset forces
+    force=0.0;
+
+    //calculate forces from geometry constraints
+    constraintForces(crds,force,(constrained.n*chunk)/nChunks,(constrained.n*(chunk+1))/nChunks);
+
+    //calculate force from bonds
+    bondForces(crds,force,(nBonds*chunk)/nChunks,(nBonds*(chunk+1))/nChunks);
+
+    //calculate force from angles
+    Vec c0, c1, c2, f0, f1, f2;
+    for(int i=(nAngles*chunk)/nChunks; i<(nAngles*(chunk+1))/nChunks; ++i){
+        getCrd(crds,angles[3*i],c0);
+        getCrd(crds,angles[3*i+1],c1);
+        getCrd(crds,angles[3*i+2],c2);
+        f0.fill(0.0);
+        f1.fill(0.0);
+        f2.fill(0.0);
+        angleForce(c0,c1,c2,f0,f1,f2,i);
+        addForce(force,angles[3*i],f0);
+        addForce(force,angles[3*i+1],f1);
+        addForce(force,angles[3*i+2],f2);
+    }
+
+    //calculate forces from repulsions
+    repForces(crds,force,(nRep*chunk)/nChunks,(nRep*(chunk+1))/nChunks);
+
+    //calculate forces from intersections
+    Vec c3, fx[4];
+    for(int i=(nInterx*chunk)/nChunks; i<(nInterx*(chunk+1))/nChunks; ++i){
+        getCrd(crds,interx[4*i],c0);
+        getCrd(crds,interx[4*i+1],c1);
+        getCrd(crds,interx[4*i+2],c2);
+        getCrd(crds,interx[4*i+3],c3);
+        for(int j=0; j<4; ++j) fx[j].fill(0.0);
+        interxForce(c0,c1,c2,c3,fx[0],fx[1],fx[2],fx[3]);
+        for(int j=0; j<4; ++j) addForce(force,interx[4*i+j],fx[j]);
+    }
+
+    //kill forces on fixed atoms
+    for(int i=0; i<fixed.n; ++i){
+        for(int d=0; d<D; ++d) force[D*fixed[i]+d]=0.0;
+    }
+}
+
+template <int D, typename T>
+void BasePotentialCart<D,T>::chunkEnergy(col_vector<T> &crds, T &energy, int chunk, int nChunks) {
+    //calculate energy from contiguous chunk of each interaction list
+
+    //reset energy
+    energy=0.0;
+
+    //calculate energy from geometry constraints
+    constraintEnergies(crds,energy,(constrained.n*chunk)/nChunks,(constrained.n*(chunk+1))/nChunks);
+
+    //calculate energy from bonds
+    bondEnergies(crds,energy,(nBonds*chunk)/nChunks,(nBonds*(chunk+1))/nChunks);
+
+    //calculate energy from angles
+    Vec c0, c1, c2, c3;
+    for(int i=(nAngles*chunk)/nChunks; i<(nAngles*(chunk+1))/nChunks; ++i){
+        getCrd(crds,angles[3*i],c0);
+        getCrd(crds,angles[3*i+1],c1);
+        getCrd(crds,angles[3*i+2],c2);
+        angleEnergy(c0,c1,c2,energy,i);
+    }
+
+    //calculate energy from repulsions
+    repEnergies(crds,energy,(nRep*chunk)/nChunks,(nRep*(chunk+1))/nChunks);
+
+    //calculate energy from intersections
+    for(int i=(nInterx*chunk)/nChunks; i<(nInterx*(chunk+1))/nChunks; ++i){
+        getCrd(crds,interx[4*i],c0);
+        getCrd(crds,interx[4*i+1],c1);
+        getCrd(crds,interx[4*i+2],c2);
+        getCrd(crds,interx[4*i+3],c3);
+        interxEnergy(c0,c1,c2,c3,energy);
+    }
+
+}
+
+template <int D, typename T>
+void BasePotentialCart<D,T>::constraintForces(col_vector<T> &crds, col_vector<T> &force, int begin, int end) {
+    //no geometry constraints
+    return;
+}
+
+template <int D, typename T>
+void BasePotentialCart<D,T>::constraintEnergies(col_vector<T> &crds, T &energy, int begin, int end) {
+    //no geometry constraints
+    return;
+}
+
+template <int D, typename T>
+void BasePotentialCart<D,T>::bondForces(col_vector<T> &crds, col_vector<T> &force, int begin, int end) {
+    //calculate force from bonds in range
+    Vec c0, c1, f0, f1;
+    for(int i=begin; i<end; ++i){
+        getCrd(crds,bonds[2*i],c0);
+        getCrd(crds,bonds[2*i+1],c1);
+        f0.fill(0.0);
+        f1.fill(0.0);
+        bondForce(c0,c1,f0,f1,i);
+        addForce(force,bonds[2*i],f0);
+        addForce(force,bonds[2*i+1],f1);
+    }
+}
+
+template <int D, typename T>
+void BasePotentialCart<D,T>::bondEnergies(col_vector<T> &crds, T &energy, int begin, int end) {
+    //calculate energy from bonds in range
+    Vec c0, c1;
+    for(int i=begin; i<end; ++i){
+        getCrd(crds,bonds[2*i],c0);
+        getCrd(crds,bonds[2*i+1],c1);
+        bondEnergy(c0,c1,energy,i);
+    }
+}
+
+template <int D, typename T>
+void BasePotentialCart<D,T>::repForces(col_vector<T> &crds, col_vector<T> &force, int begin, int end) {
+    //calculate force from repulsions in range
+    Vec c0, c1, f0, f1;
+    for(int i=begin; i<end; ++i){
+        getCrd(crds,repulsions[2*i],c0);
+        getCrd(crds,repulsions[2*i+1],c1);
+        f0.fill(0.0);
+        f1.fill(0.0);
+        repForce(c0,c1,f0,f1,i);
+        addForce(force,repulsions[2*i],f0);
+        addForce(force,repulsions[2*i+1],f1);
+    }
+}
+
+template <int D, typename T>
+void BasePotentialCart<D,T>::repEnergies(col_vector<T> &crds, T &energy, int begin, int end) {
+    //calculate energy from repulsions in range
+    Vec c0, c1;
+    for(int i=begin; i<end; ++i){
+        getCrd(crds,repulsions[2*i],c0);
+        getCrd(crds,repulsions[2*i+1],c1);
+        repEnergy(c0,c1,energy,i);
+    }
+}
+
+//##### HARMONIC CARTESIAN #####
+template <int D, typename T, typename Constraint>
+HC<D,T,Constraint>::HC(){
+    //default constructor
+}
+
+template <int D, typename T, typename Constraint>
+HC<D,T,Constraint>::HC(const ArenaVector<int> &bondsIn, const ArenaVector<int> &anglesIn, const ArenaVector<int> &repIn, const ArenaVector<int> &fixedIn, const ArenaVector<int> &interxIn,
+                       double bondKIn, double bondR0In, double angleKIn, double angleR0In,
+                       const ArenaVector<int> &constrIn, const Constraint &constraintIn):BasePotentialCart<D,T>(bondsIn,anglesIn,repIn,fixedIn,interxIn,constrIn) {
+    //construct with single parameter set for bonds and angles
+    //turn single values into vectors
+    bondK=col_vector<T>(this->nBonds);
+    bondR0=col_vector<T>(this->nBonds);
+    angleK=col_vector<T>(this->nAngles);
+    angleR0=col_vector<T>(this->nAngles);
+    bondK=bondKIn;
+    bondR0=bondR0In;
+    angleK=angleKIn;
+    angleR0=angleR0In;
+    constraint=constraintIn;
+}
+
+template <int D, typename T, typename Constraint>
+HC<D,T,Constraint>::HC(const ArenaVector<int> &bondsIn, const ArenaVector<int> &anglesIn, const ArenaVector<int> &repIn, const ArenaVector<int> &fixedIn, const ArenaVector<int> &interxIn,
+                       const ArenaVector<double> &bondKIn, const ArenaVector<double> &bondR0In, const ArenaVector<double> &angleKIn, const ArenaVector<double> &angleR0In,
+                       const ArenaVector<int> &constrIn, const Constraint &constraintIn):BasePotentialCart<D,T>(bondsIn,anglesIn,repIn,fixedIn,interxIn,constrIn) {
+    //construct with parameter set for individual bonds and angles
+    bondK=col_vector<T>(bondKIn.size());
+    bondR0=col_vector<T>(bondR0In.size());
+    angleK=col_vector<T>(angleKIn.size());
+    angleR0=col_vector<T>(angleR0In.size());
+    for(int i=0; i<bondKIn.size(); ++i) bondK[i]=bondKIn[i];
+    for(int i=0; i<bondR0In.size(); ++i) bondR0[i]=bondR0In[i];
+    for(int i=0; i<angleKIn.size(); ++i) angleK[i]=angleKIn[i];
+    for(int i=0; i<angleR0In.size(); ++i) angleR0[i]=angleR0In[i];
+    constraint=constraintIn;
+}
+
+template <int D, typename T, typename Constraint>
+void HC<D,T,Constraint>::constraintForces(col_vector<T> &crds, col_vector<T> &force, int begin, int end) {
+    //calculate force from geometry constraints in range
+    Vec c0, f0;
+    for(int i=begin; i<end; ++i){
+        this->getCrd(crds,this->constrained[i],c0);
+        constraint.force(c0,f0);
+        this->addForce(force,this->constrained[i],f0);
+    }
+}
+
+template <int D, typename T, typename Constraint>
+void HC<D,T,Constraint>::constraintEnergies(col_vector<T> &crds, T &energy, int begin, int end) {
+    //calculate energy from geometry constraints in range
+    Vec c0;
+    for(int i=begin; i<end; ++i){
+        this->getCrd(crds,this->constrained[i],c0);
+        constraint.energy(c0,energy);
+    }
+}
+
+template <int D, typename T, typename Constraint>
+inline void HC<D,T,Constraint>::bondForce(const Vec &c0, const Vec &c1, Vec &f0, Vec &f1, int paramRef) {
+    //calculate force from single harmonic bond, f=-k(r-r0)
+    Vec f;
+    T r=sqrt(separationSq<D,T>(c0,c1,f));
+    T mag=-bondK[paramRef]*(r-bondR0[paramRef])/r;
+    for(int d=0; d<D; ++d){
+        f[d]*=mag;
+        f0[d]-=f[d];
+        f1[d]+=f[d];
+    }
+}
+
+template <int D, typename T, typename Constraint>
+inline void HC<D,T,Constraint>::angleForce(const Vec &c0, const Vec &c1, const Vec &c2, Vec &f0, Vec &f1, Vec &f2, int paramRef) {
+    //calculate force as single harmonic bond, f=-k(r-r0), between outside atoms of angle: neglect central atom
+    Vec f;
+    T r=sqrt(separationSq<D,T>(c0,c2,f));
+    T mag=-angleK[paramRef]*(r-angleR0[paramRef])/r;
+    for(int d=0; d<D; ++d){
+        f[d]*=mag;
+        f0[d]-=f[d];
+        f2[d]+=f[d];
+    }
+}
+
+template <int D, typename T, typename Constraint>
+inline void HC<D,T,Constraint>::repForce(const Vec &c0, const Vec &c1, Vec &f0, Vec &f1, int paramRef) {
+    //none
+    return;
+}
+
+template <int D, typename T, typename Constraint>
+inline void HC<D,T,Constraint>::bondEnergy(const Vec &c0, const Vec &c1, T &e, int paramRef) {
+    //calculate energy of a single harmonic bond, U=0.5k(r-r0)^2
+    Vec dx;
+    T r=sqrt(separationSq<D,T>(c0,c1,dx));
+    e+=0.5*bondK[paramRef]*pow((r-bondR0[paramRef]),2);
+}
+
+template <int D, typename T, typename Constraint>
+inline void HC<D,T,Constraint>::angleEnergy(const Vec &c0, const Vec &c1, const Vec &c2, T &e, int paramRef) {
+    //calculate energy of single harmonic bond, U=0.5k(r-r0)^2, between outside atoms of angle
+    Vec dx;
+    T r=sqrt(separationSq<D,T>(c0,c2,dx));
+    e+=0.5*angleK[paramRef]*pow((r-angleR0[paramRef]),2);
+}
+
+template <int D, typename T, typename Constraint>
+inline void HC<D,T,Constraint>::repEnergy(const Vec &c0, const Vec &c1, T &e, int paramRef) {
+    //none
+    return;
+}
+
+template <int D, typename T, typename Constraint>
+inline void HC<D,T,Constraint>::interxEnergy(const Vec &c0, const Vec &c1, const Vec &c2, const Vec &c3, T &e) {
+    //calculate energy of single intersection pair, delta function
+    if(properIntersection(c0,c1,c2,c3)) e=numeric_limits<T>::infinity();
+}
+
+template <int D, typename T, typename Constraint>
+inline void HC<D,T,Constraint>::interxForce(const Vec &c0, const Vec &c1, const Vec &c2, const Vec &c3, Vec &f0, Vec &f1, Vec &f2, Vec &f3) {
+    //none, delta function has no gradient
+    return;
+}
+
+//##### HARMONIC CARTESIAN WITH LJ REPULSIONS #####
+template <int D, typename T, typename Constraint>
+HLJC<D,T,Constraint>::HLJC(){
+    //default constructor
+    repTable=nullptr;
+    interxK=0.0;
+}
+
+template <int D, typename T, typename Constraint>
+HLJC<D,T,Constraint>::HLJC(const ArenaVector<int> &bondsIn, const ArenaVector<int> &anglesIn, const ArenaVector<int> &repIn, const ArenaVector<int> &fixedIn, const ArenaVector<int> &interxIn,
+                           double bondKIn, double bondR0In, double repEpIn, double repR0In,
+                           const ArenaVector<int> &constrIn, const Constraint &constraintIn):BasePotentialCart<D,T>(bondsIn,anglesIn,repIn,fixedIn,interxIn,constrIn) {
+    //construct with single parameter set for bonds and repulsions
+    nBondTypes=1;
+    bondTypes=col_vector<unsigned char>(this->nBonds);
+    bondTypes=0;
+    bondK[0]=bondKIn;
+    bondR0[0]=bondR0In;
+    repEpsilon=repEpIn;
+    repR02=repR0In*repR0In;
+    repTable=nullptr;
+    interxK=0.0;
+    constraint=constraintIn;
+}
+
+template <int D, typename T, typename Constraint>
+HLJC<D,T,Constraint>::HLJC(const ArenaVector<int> &bondsIn, const ArenaVector<int> &anglesIn, const ArenaVector<int> &repIn, const ArenaVector<int> &fixedIn, const ArenaVector<int> &interxIn,
+                           const ArenaVector<int> &bondTypesIn, const ArenaVector<double> &bondKIn, const ArenaVector<double> &bondR0In, double repEpIn, double repR0In,
+                           const ArenaVector<int> &constrIn, const Constraint &constraintIn):BasePotentialCart<D,T>(bondsIn,anglesIn,repIn,fixedIn,interxIn,constrIn) {
+    //construct with type code for each bond and parameter table for each bond type
+    setBondTypes(bondTypesIn,bondKIn,bondR0In,nBondTypes,bondTypes,bondK,bondR0);
+    repEpsilon=repEpIn;
+    repR02=repR0In*repR0In;
+    repTable=nullptr;
+    interxK=0.0;
+    constraint=constraintIn;
+}
+
+template <int D, typename T, typename Constraint>
+void HLJC<D,T,Constraint>::setRepulsionTable(const PairTable<T> *table) {
+    //use tabulated repulsion in place of analytic LJ, table must outlive model
+    repTable=table;
+}
+
+template <int D, typename T, typename Constraint>
+void HLJC<D,T,Constraint>::setIntersectionPenalty(double k) {
+    //constant of soft penalty on intersecting edges in interx list, zero for none
+    interxK=k;
+}
+
+template <int D, typename T, typename Constraint>
+void HLJC<D,T,Constraint>::constraintForces(col_vector<T> &crds, col_vector<T> &force, int begin, int end) {
+    //calculate force from geometry constraints in range
+    Vec c0, f0;
+    for(int i=begin; i<end; ++i){
+        this->getCrd(crds,this->constrained[i],c0);
+        constraint.force(c0,f0);
+        this->addForce(force,this->constrained[i],f0);
+    }
+}
+
+template <int D, typename T, typename Constraint>
+void HLJC<D,T,Constraint>::constraintEnergies(col_vector<T> &crds, T &energy, int begin, int end) {
+    //calculate energy from geometry constraints in range
+    Vec c0;
+    for(int i=begin; i<end; ++i){
+        this->getCrd(crds,this->constrained[i],c0);
+        constraint.energy(c0,energy);
+    }
+}
+
+template <int D, typename T, typename Constraint>
+void HLJC<D,T,Constraint>::bondForces(col_vector<T> &crds, col_vector<T> &force, int begin, int end) {
+    //calculate force from bonds in range, selecting kernel by number of bond types
+    if(nBondTypes==1) harmonicBondForces<true>(crds,force,begin,end);
+    else harmonicBondForces<false>(crds,force,begin,end);
+}
+
+template <int D, typename T, typename Constraint>
+void HLJC<D,T,Constraint>::bondEnergies(col_vector<T> &crds, T &energy, int begin, int end) {
+    //calculate energy from bonds in range, selecting kernel by number of bond types
+    if(nBondTypes==1) harmonicBondEnergies<true>(crds,energy,begin,end);
+    else harmonicBondEnergies<false>(crds,energy,begin,end);
+}
+
+template <int D, typename T, typename Constraint>
+template <bool singleType>
+void HLJC<D,T,Constraint>::harmonicBondForces(col_vector<T> &crds, col_vector<T> &force, int begin, int end) {
+    //calculate force from harmonic bonds in range, f=-k(r-r0), parameters only looked up if multiple types
+    int x0, x1; //indices
+    T k=bondK[0], r0=bondR0[0];
+    T r, mag;
+    Vec dx;
+    for(int i=begin; i<end; ++i){
+        if(!singleType){
+            k=bondK[bondTypes[i]];
+            r0=bondR0[bondTypes[i]];
+        }
+        x0=D*this->bonds[2*i];
+        x1=D*this->bonds[2*i+1];
+        r=sqrt(separationSq<D,T>(crds,x0,x1,dx));
+        mag=-k*(r-r0)/r;
+        for(int d=0; d<D; ++d){
+            dx[d]*=mag;
+            force[x0+d]-=dx[d];
+            force[x1+d]+=dx[d];
+        }
+    }
+}
+
+template <int D, typename T, typename Constraint>
+template <bool singleType>
+void HLJC<D,T,Constraint>::harmonicBondEnergies(col_vector<T> &crds, T &energy, int begin, int end) {
+    //calculate energy of harmonic bonds in range, U=0.5k(r-r0)^2, parameters only looked up if multiple types
+    int x0, x1; //indices
+    T k=bondK[0], r0=bondR0[0];
+    T r;
+    Vec dx;
+    for(int i=begin; i<end; ++i){
+        if(!singleType){
+            k=bondK[bondTypes[i]];
+            r0=bondR0[bondTypes[i]];
+        }
+        x0=D*this->bonds[2*i];
+        x1=D*this->bonds[2*i+1];
+        r=sqrt(separationSq<D,T>(crds,x0,x1,dx));
+        energy+=0.5*k*pow((r-r0),2);
+    }
+}
+
+template <int D, typename T, typename Constraint>
+void HLJC<D,T,Constraint>::repForces(col_vector<T> &crds, col_vector<T> &force, int begin, int end) {
+    //calculate force from repulsions in range, selecting kernel by repulsion type
+    if(repTable==nullptr) ljRepForces(crds,force,begin,end);
+    else tableRepForces(crds,force,begin,end);
+}
+
+template <int D, typename T, typename Constraint>
+void HLJC<D,T,Constraint>::repEnergies(col_vector<T> &crds, T &energy, int begin, int end) {
+    //calculate energy from repulsions in range, selecting kernel by repulsion type
+    if(repTable==nullptr) ljRepEnergies(crds,energy,begin,end);
+    else tableRepEnergies(crds,energy,begin,end);
+}
+
+template <int D, typename T, typename Constraint>
+void HLJC<D,T,Constraint>::ljRepForces(col_vector<T> &crds, col_vector<T> &force, int begin, int end) {
+    //calculate force from LJ repulsions in range, F=12ep/r**2(r*-12-r**-6)
+    int x0, x1; //indices
+    T r2, d2, d12, d24, mag;
+    Vec dx;
+    for(int i=begin; i<end; ++i){
+        x0=D*this->repulsions[2*i];
+        x1=D*this->repulsions[2*i+1];
+        r2=separationSq<D,T>(crds,x0,x1,dx);
+        if(r2>=repR02) continue; //if greater than cutoff
+        d2=repR02/r2;
+        d12=pow(d2,6);
+        d24=pow(d12,2);
+        mag=24.0*repEpsilon*(d24-d12)/r2;
+        for(int d=0; d<D; ++d){
+            dx[d]*=mag;
+            force[x0+d]-=dx[d];
+            force[x1+d]+=dx[d];
+        }
+    }
+}
+
+template <int D, typename T, typename Constraint>
+void HLJC<D,T,Constraint>::ljRepEnergies(col_vector<T> &crds, T &energy, int begin, int end) {
+    //calculate energy of LJ repulsions in range, U=ep*(r-24-2r-12)+ep
+    int x0, x1; //indices
+    T r2, d2, d12, d24;
+    Vec dx;
+    for(int i=begin; i<end; ++i){
+        x0=D*this->repulsions[2*i];
+        x1=D*this->repulsions[2*i+1];
+        r2=separationSq<D,T>(crds,x0,x1,dx);
+        if(r2>=repR02) continue; //if greater than cutoff
+        d2=repR02/r2;
+        d12=pow(d2,6);
+        d24=pow(d12,2);
+        energy+=repEpsilon*(d24-2.0*d12)+repEpsilon;
+    }
+}
+
+template <int D, typename T, typename Constraint>
+void HLJC<D,T,Constraint>::tableRepForces(col_vector<T> &crds, col_vector<T> &force, int begin, int end) {
+    //calculate force from tabulated repulsions in range
+    int x0, x1; //indices
+    T r2, mag;
+    T rc2=repTable->sCut;
+    Vec dx;
+    for(int i=begin; i<end; ++i){
+        x0=D*this->repulsions[2*i];
+        x1=D*this->repulsions[2*i+1];
+        r2=separationSq<D,T>(crds,x0,x1,dx);
+        if(r2>=rc2) continue; //if greater than cutoff
+        mag=repTable->forceFactor(r2);
+        for(int d=0; d<D; ++d){
+            dx[d]*=mag;
+            force[x0+d]-=dx[d];
+            force[x1+d]+=dx[d];
+        }
+    }
+}
+
+template <int D, typename T, typename Constraint>
+void HLJC<D,T,Constraint>::tableRepEnergies(col_vector<T> &crds, T &energy, int begin, int end) {
+    //calculate energy of tabulated repulsions in range
+    int x0, x1; //indices
+    T r2;
+    T rc2=repTable->sCut;
+    Vec dx;
+    for(int i=begin; i<end; ++i){
+        x0=D*this->repulsions[2*i];
+        x1=D*this->repulsions[2*i+1];
+        r2=separationSq<D,T>(crds,x0,x1,dx);
+        if(r2>=rc2) continue; //if greater than cutoff
+        energy+=repTable->energy(r2);
+    }
+}
+
+template <int D, typename T, typename Constraint>
+inline void HLJC<D,T,Constraint>::bondForce(const Vec &c0, const Vec &c1, Vec &f0, Vec &f1, int paramRef) {
+    //calculate force from single harmonic bond, f=-k(r-r0)
+    Vec f;
+    T r=sqrt(separationSq<D,T>(c0,c1,f));
+    T mag=-bondK[bondTypes[paramRef]]*(r-bondR0[bondTypes[paramRef]])/r;
+    for(int d=0; d<D; ++d){
+        f[d]*=mag;
+        f0[d]-=f[d];
+        f1[d]+=f[d];
+    }
+}
+
+template <int D, typename T, typename Constraint>
+inline void HLJC<D,T,Constraint>::angleForce(const Vec &c0, const Vec &c1, const Vec &c2, Vec &f0, Vec &f1, Vec &f2, int paramRef) {
+    //none
+    return;
+}
+
+template <int D, typename T, typename Constraint>
+inline void HLJC<D,T,Constraint>::repForce(const Vec &c0, const Vec &c1, Vec &f0, Vec &f1, int paramRef) {
+    //tabulated repulsion or shifted and truncated lennard-jones potential F=12ep/r**2(r*-12-r**-6)
+    Vec f;
+    T r2=separationSq<D,T>(c0,c1,f);
+    T mag;
+    if(repTable!=nullptr) mag=repTable->forceFactor(r2);
+    else{
+        if(r2>=repR02) return; //if greater than cutoff
+        T d2=repR02/r2;
+        T d12=pow(d2,6);
+        T d24=pow(d12,2);
+        mag=24.0*repEpsilon*(d24-d12)/r2;
+    }
+    for(int d=0; d<D; ++d){
+        f[d]*=mag;
+        f0[d]-=f[d];
+        f1[d]+=f[d];
+    }
+}
+
+template <int D, typename T, typename Constraint>
+inline void HLJC<D,T,Constraint>::bondEnergy(const Vec &c0, const Vec &c1, T &e, int paramRef) {
+    //calculate energy of a single harmonic bond, U=0.5k(r-r0)^2
+    Vec dx;
+    T r=sqrt(separationSq<D,T>(c0,c1,dx));
+    e+=0.5*bondK[bondTypes[paramRef]]*pow((r-bondR0[bondTypes[paramRef]]),2);
+}
+
+template <int D, typename T, typename Constraint>
+inline void HLJC<D,T,Constraint>::angleEnergy(const Vec &c0, const Vec &c1, const Vec &c2, T &e, int paramRef) {
+    //none
+    return;
+}
+
+template <int D, typename T, typename Constraint>
+inline void HLJC<D,T,Constraint>::repEnergy(const Vec &c0, const Vec &c1, T &e, int paramRef) {
+    //tabulated repulsion or shifted and truncated LJ potential U=ep*(r-24-2r-12)+ep
+    Vec dx;
+    T r2=separationSq<D,T>(c0,c1,dx);
+    if(repTable!=nullptr){
+        e+=repTable->energy(r2);
+        return;
+    }
+    if(r2>=repR02) return; //if greater than cutoff
+    T d2=repR02/r2;
+    T d12=pow(d2,6);
+    T d24=pow(d12,2);
+    e+=repEpsilon*(d24-2.0*d12)+repEpsilon;
+}
+
+template <int D, typename T, typename Constraint>
+inline void HLJC<D,T,Constraint>::interxEnergy(const Vec &c0, const Vec &c1, const Vec &c2, const Vec &c3, T &e) {
+    //soft penalty on depth of intersection, none if penalty off
+    if(interxK==0.0) return;
+    intersectionPenalty(c0,c1,c2,c3,interxK,e,(Vec*)nullptr);
+}
+
+template <int D, typename T, typename Constraint>
+inline void HLJC<D,T,Constraint>::interxForce(const Vec &c0, const Vec &c1, const Vec &c2, const Vec &c3, Vec &f0, Vec &f1, Vec &f2, Vec &f3) {
+    //force from soft penalty on depth of intersection
+    if(interxK==0.0) return;
+    Vec f[4]={f0,f1,f2,f3};
+    T e=0.0;
+    intersectionPenalty(c0,c1,c2,c3,interxK,e,f);
+    f0=f[0];
+    f1=f[1];
+    f2=f[2];
+    f3=f[3];
+}
@@ -9,6 +9,6 @@ Ring::Ring(){
 Ring::Ring(int idValue, int maxU, int maxR) {
     //constructor
     id=idValue;
-    units=Connector(maxU);
-    rings=Connector(maxR);
+    units=Connector<ringConnectorSize>(maxU);
+    rings=Connector<ringConnectorSize>(maxR);
 }
@@ -6,11 +6,13 @@
 
 using namespace std;
 
+const int ringConnectorSize=10; //inline capacity of ring connectors, larger rings stored on heap
+
 struct Ring{
     //contains unit and ring connection information
 
     int id;//unique identifier
-    Connector units, rings; //connections
+    Connector<ringConnectorSize> units, rings; //connections
 
     Ring(); //constructor
     Ring(int idValue, int maxU, int maxR); //constructor
@@ -0,0 +1,259 @@
+#include "shapes.h"
+
+//##### BASE SHAPE #####
+Shape::~Shape() {
+    //virtual destructor
+}
+
+bool Shape::contains(double x, double y, double size) const {
+    //inside where signed distance negative
+    return distance(x,y,size)<0.0;
+}
+
+double Shape::gauge(double, double) const {
+    //not defined
+    return numeric_limits<double>::infinity();
+}
+
+int Shape::nSides() const {
+    //no sides
+    return 0;
+}
+
+int Shape::side(double, double, double) const {
+    //no sides
+    return -1;
+}
+
+//##### ANALYTIC SHAPES #####
+double CircleShape::distance(double x, double y, double size) const {
+    //distance from centre less radius
+    return sqrt(x*x+y*y)-size;
+}
+
+bool CircleShape::contains(double x, double y, double size) const {
+    //compare squared distances, avoiding square root
+    return x*x+y*y<size*size;
+}
+
+double CircleShape::gauge(double x, double y) const {
+    //radius through point
+    return sqrt(x*x+y*y);
+}
+
+double SquareShape::distance(double x, double y, double size) const {
+    //distance to box [-size,size]^2, differences ordered so sign exact at boundary
+    double dx=max(-x-size,x-size), dy=max(-y-size,y-size);
+    if(dx<0.0 && dy<0.0) return max(dx,dy);
+    return sqrt(pow(max(dx,0.0),2)+pow(max(dy,0.0),2));
+}
+
+double SquareShape::gauge(double x, double y) const {
+    //half width through point
+    return max(fabs(x),fabs(y));
+}
+
+int SquareShape::nSides() const {
+    //top, bottom, left, right
+    return 4;
+}
+
+int SquareShape::side(double x, double y, double size) const {
+    //nearest side, ties resolved in order top, bottom, left, right
+    double dt=fabs(y-size), db=fabs(y+size), dl=fabs(x+size), dr=fabs(x-size);
+    if(dt<=db && dt<=dl && dt<=dr) return 0;
+    else if(db<=dl && db<=dr) return 1;
+    else if(dl<=dr) return 2;
+    else return 3;
+}
+
+double QuadrantShape::distance(double x, double y, double size) const {
+    //distance to box [0,size]^2, differences ordered so sign exact at boundary
+    double dx=max(-x,x-size), dy=max(-y,y-size);
+    if(dx<0.0 && dy<0.0) return max(dx,dy);
+    return sqrt(pow(max(dx,0.0),2)+pow(max(dy,0.0),2));
+}
+
+double QuadrantShape::gauge(double x, double y) const {
+    //width through point
+    return max(max(x,y),0.0);
+}
+
+int QuadrantShape::nSides() const {
+    //top, bottom, left, right
+    return 4;
+}
+
+int QuadrantShape::side(double x, double y, double size) const {
+    //nearest side, ties resolved in order top, bottom, left, right
+    double dt=fabs(y-size), db=fabs(y), dl=fabs(x), dr=fabs(x-size);
+    if(dt<=db && dt<=dl && dt<=dr) return 0;
+    else if(db<=dl && db<=dr) return 1;
+    else if(dl<=dr) return 2;
+    else return 3;
+}
+
+double HeartShape::distance(double x, double y, double size) const {
+    //implicit function x^2+(1.25y-sqrt|x|)^2-1 at unit size, negative inside
+    x/=size;
+    y/=size;
+    double f=x*x+pow((1.25*y-sqrt(fabs(x))),2);
+    return (f-1.0)*size;
+}
+
+//##### POLYGON MASK #####
+PolygonShape::PolygonShape() {
+    //default constructor
+    xMin=0.0;
+    xMax=0.0;
+    yMin=0.0;
+    yMax=0.0;
+    nSlabs=0;
+    slabInvHeight=0.0;
+}
+
+bool PolygonShape::read(string filename) {
+    //read x y of each vertex from file, rows without two values skipped, closing vertex optional
+    //growth starts from origin so polygon must enclose it
+
+    ifstream maskFile(filename, ios::in);
+    if(!maskFile.good()) return false;
+    vector< vector<double> > rows;
+    readFileAll(maskFile,rows);
+    maskFile.close();
+
+    vx.clear();
+    vy.clear();
+    for(int i=0; i<rows.size(); ++i){
+        if(rows[i].size()<2) continue;
+        vx.push_back(rows[i][0]);
+        vy.push_back(rows[i][1]);
+    }
+    if(vx.size()>1 && vx.back()==vx[0] && vy.back()==vy[0]){
+        vx.pop_back();
+        vy.pop_back();
+    }
+    if(vx.size()<3) return false;
+
+    xMin=*min_element(vx.begin(),vx.end());
+    xMax=*max_element(vx.begin(),vx.end());
+    yMin=*min_element(vy.begin(),vy.end());
+    yMax=*max_element(vy.begin(),vy.end());
+    if(xMax<=xMin || yMax<=yMin) return false;
+    index();
+    return contains(0.0,0.0,1.0);
+}
+
+void PolygonShape::index() {
+    //count edges overlapping each slab then fill compressed rows
+
+    int n=vx.size();
+    nSlabs=n;
+    slabInvHeight=nSlabs/(yMax-yMin);
+    slabStart.assign(nSlabs+1,0);
+    vector<int> lo(n), hi(n);
+    for(int e=0; e<n; ++e){
+        int f=(e+1)%n;
+        lo[e]=min(nSlabs-1,max(0,int((min(vy[e],vy[f])-yMin)*slabInvHeight)));
+        hi[e]=min(nSlabs-1,max(0,int((max(vy[e],vy[f])-yMin)*slabInvHeight)));
+        for(int s=lo[e]; s<=hi[e]; ++s) ++slabStart[s+1];
+    }
+    for(int s=0; s<nSlabs; ++s) slabStart[s+1]+=slabStart[s];
+    slabEdges.resize(slabStart[nSlabs]);
+    vector<int> fill(slabStart.begin(),slabStart.end()-1);
+    for(int e=0; e<n; ++e){
+        for(int s=lo[e]; s<=hi[e]; ++s) slabEdges[fill[s]++]=e;
+    }
+}
+
+double PolygonShape::edgeDistanceSq(int e, double x, double y) const {
+    //project point onto edge, clamped to end points
+    int f=(e+1)%vx.size();
+    double ex=vx[f]-vx[e], ey=vy[f]-vy[e], wx=x-vx[e], wy=y-vy[e];
+    double t=(ex*wx+ey*wy)/(ex*ex+ey*ey);
+    t=min(1.0,max(0.0,t));
+    return pow(wx-t*ex,2)+pow(wy-t*ey,2);
+}
+
+bool PolygonShape::contains(double x, double y, double size) const {
+    //crossing number of ray in +x direction, only edges in slab of point tested
+    x/=size;
+    y/=size;
+    if(x<=xMin || x>=xMax || y<=yMin || y>=yMax) return false;
+    int s=min(nSlabs-1,int((y-yMin)*slabInvHeight));
+    int n=vx.size();
+    bool inside=false;
+    for(int i=slabStart[s]; i<slabStart[s+1]; ++i){
+        int e=slabEdges[i], f=(e+1)%n;
+        if((vy[e]>y)!=(vy[f]>y)){
+            double xCross=vx[e]+(y-vy[e])*(vx[f]-vx[e])/(vy[f]-vy[e]);
+            if(x<xCross) inside=!inside;
+        }
+    }
+    return inside;
+}
+
+double PolygonShape::distance(double x, double y, double size) const {
+    //distance to nearest edge, negative if inside
+    double d2=numeric_limits<double>::infinity();
+    for(int e=0; e<vx.size(); ++e) d2=min(d2,edgeDistanceSq(e,x/size,y/size));
+    double d=sqrt(d2)*size;
+    return contains(x,y,size) ? -d : d;
+}
+
+double PolygonShape::gauge(double x, double y) const {
+    //size at which first edge along ray from origin reaches point, t*p=a+u*(b-a) solved for nearest t>0
+    if(x==0.0 && y==0.0) return 0.0;
+    int n=vx.size();
+    double tMin=numeric_limits<double>::infinity();
+    for(int e=0; e<n; ++e){
+        int f=(e+1)%n;
+        double dx=vx[f]-vx[e], dy=vy[f]-vy[e];
+        double den=x*dy-y*dx;
+        if(den==0.0) continue;
+        double t=(vx[e]*dy-vy[e]*dx)/den;
+        double u=(vx[e]*y-vy[e]*x)/den;
+        if(t>0.0 && u>=0.0 && u<=1.0) tMin=min(tMin,t);
+    }
+    if(isinf(tMin)) return numeric_limits<double>::infinity();
+    return 1.0/tMin;
+}
+
+int PolygonShape::nSides() const {
+    //one side per edge
+    return vx.size();
+}
+
+int PolygonShape::side(double x, double y, double size) const {
+    //nearest edge
+    int nearest=0;
+    double d2Min=numeric_limits<double>::infinity(), d2;
+    for(int e=0; e<vx.size(); ++e){
+        d2=edgeDistanceSq(e,x/size,y/size);
+        if(d2<d2Min){
+            d2Min=d2;
+            nearest=e;
+        }
+    }
+    return nearest;
+}
+
+//##### FACTORY #####
+Shape* makeShape(string code, int dimensionality, string maskFilename) {
+    //2D codes circle C, square S, quadrant X, heart H, polygon mask P, 3D sphere S grown as circle projected onto x-y plane
+    if(dimensionality==2){
+        if(code=="C") return new CircleShape;
+        else if(code=="S") return new SquareShape;
+        else if(code=="X") return new QuadrantShape;
+        else if(code=="H") return new HeartShape;
+        else if(code=="P"){
+            PolygonShape *polygon=new PolygonShape;
+            if(polygon->read(maskFilename)) return polygon;
+            delete polygon;
+        }
+    }
+    else if(dimensionality==3){
+        if(code=="S") return new CircleShape;
+    }
+    return nullptr;
+}
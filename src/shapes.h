@@ -0,0 +1,97 @@
+//Regions of network growth in x-y plane, as signed distance functors scaled by region size
+//Shape chosen once from geometry code, so growth and percolation analysis test points without string comparisons
+#ifndef MX2_SHAPES_H
+#define MX2_SHAPES_H
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "easyIO.h"
+
+using namespace std;
+
+//##### BASE SHAPE #####
+class Shape {
+    //region centred on origin which grows with size, inside where signed distance negative
+
+public:
+    virtual ~Shape();
+
+    //methods
+    virtual double distance(double x, double y, double size) const=0; //signed distance to boundary, negative inside
+    virtual bool contains(double x, double y, double size) const; //point strictly inside shape
+    virtual double gauge(double x, double y) const; //smallest size of shape containing point, infinite if none
+    virtual int nSides() const; //number of sides for percolation, 0 if not defined
+    virtual int side(double x, double y, double size) const; //side of shape nearest point, -1 if not defined
+};
+
+//##### ANALYTIC SHAPES #####
+class CircleShape: public Shape {
+    //circle of radius size
+public:
+    double distance(double x, double y, double size) const override;
+    bool contains(double x, double y, double size) const override;
+    double gauge(double x, double y) const override;
+};
+
+class SquareShape: public Shape {
+    //square of half width size, sides top, bottom, left, right
+public:
+    double distance(double x, double y, double size) const override;
+    double gauge(double x, double y) const override;
+    int nSides() const override;
+    int side(double x, double y, double size) const override;
+};
+
+class QuadrantShape: public Shape {
+    //square of width size in positive quadrant, sides top, bottom, left, right
+public:
+    double distance(double x, double y, double size) const override;
+    double gauge(double x, double y) const override;
+    int nSides() const override;
+    int side(double x, double y, double size) const override;
+};
+
+class HeartShape: public Shape {
+    //heart of scale size, implicit function in place of exact distance
+public:
+    double distance(double x, double y, double size) const override;
+};
+
+//##### POLYGON MASK #####
+class PolygonShape: public Shape {
+    //simple polygon read from file as vertices at unit size, scaled by size about origin
+    //edges binned into horizontal slabs so inside test only crosses edges spanning slab of point
+
+    vector<double> vx, vy; //vertices in order
+    double xMin, xMax, yMin, yMax; //bounding box at unit size
+    int nSlabs; //number of slabs over bounding box
+    double slabInvHeight; //inverse height of slab
+    vector<int> slabStart, slabEdges; //edges overlapping each slab, compressed rows
+
+    void index(); //bin edges into slabs
+    double edgeDistanceSq(int e, double x, double y) const; //squared distance from point to edge at unit size
+
+public:
+    //constructors
+    PolygonShape();
+
+    //set up
+    bool read(string filename); //read vertices from file, false if fewer than three or origin not inside
+
+    //methods
+    double distance(double x, double y, double size) const override;
+    bool contains(double x, double y, double size) const override;
+    double gauge(double x, double y) const override;
+    int nSides() const override;
+    int side(double x, double y, double size) const override;
+};
+
+//##### FACTORY #####
+Shape* makeShape(string code, int dimensionality, string maskFilename); //shape for geometry code, null if not recognised
+
+#endif //MX2_SHAPES_H
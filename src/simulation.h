@@ -3,6 +3,8 @@
 
 #include <iostream>
 #include <string>
+#include <chrono>
+#include <memory>
 #include "logfile.h"
 #include "monteCarlo.h"
 #include "network2DC.h"
@@ -10,6 +12,8 @@
 
 using namespace std;
 
+const int compactionInterval=100; //number of rings grown between removal of dead atoms
+
 template <typename CrdT, typename NetT>
 class Simulation {
     //controls network growth
@@ -17,33 +21,47 @@ private:
     //Input Variables
     //IO
     string prefixIn, prefixOut; //for read in/write out
+    int networkFormat; //network written as 0 text, 1 binary, 2 both
+    int trajectoryInterval; //rings grown between trajectory frames, 0 for none
     //Network Properties
     int nTargetRings, basicMinSize, basicMaxSize; //number of rings to build, basic ring size limits
     int dimensionality; //2D/3D
     string growthGeometry; //growth geometry
+    unique_ptr<Shape> growthShape; //region of growth for geometry code
     //Monte Carlo
     MonteCarlo monteCarlo; //mc evaluator
     //Potential Model
     vector<double> potentialModel; //all k and r0 values for harmonic potential
+    PairTable<double> repulsionTable; //tabulated repulsion, empty if analytic LJ
     //Geometry Optimisation
     bool globalPreGO, globalPostGO; //points for global optimisation
     int goMaxIterations, goLocalExtent; //for descent algorithm, size of local region
+    int goThreads; //number of threads for global optimisation
+    int goTrialPrecision; //trial rings optimised in 0 double, 1 single precision, 2 both to compare
+    int goReorderInterval; //number of rings grown between hilbert reordering of network, 0 for none
     double goLineSeachInc, goConvergence; //for descent algorithm
     //Further options
     bool fullDistributions; //write full bond length/angle distributions
     bool analyseArea; //analyse ring areas
     bool convertToBilayer; //convert structure to bilayer
     bool analyseCluster; //cluster and percolation analysis
+    bool listOverlaps; //find and log all overlapping units rather than stopping at first
 
     //Monitoring
     col_vector<int> goMonitoring; //monitor geometry optimisation
     col_vector<double> mcMonitoring; //monitor ring proposal frequency
+    col_vector<int> precisionMonitoring; //rings compared, agreeing acceptance decisions, trials compared
+    col_vector<double> acceptedDP, acceptedSP; //accepted ring sizes when trials scored in double/single precision
+    double precisionEnergyDiff; //sum of absolute difference in trial energies between precisions
+    int nReorders; //number of hilbert reorderings
+    double reorderTime; //wall time spent reordering in seconds
 
     //Additional variables
     NetT masterNetwork; //main global network for simulation
     int nBasicRingSizes; //number of basic ring sizes
     double energyCutoff; //cutoff for energy to kill growth
     int killGrowth; //flag to kill growth
+    TrajectoryWriter trajectory; //growth trajectory stream
 
     //Key Methods
     void loadNetwork(Logfile &logfile);
@@ -53,8 +71,13 @@ private:
 
     //Aux Methods
     int selectActiveUnit(); //find unit to build new ring on
-    vector<int> selectUnitPath(int activeUnit); //find path of units to build new ring on
-    void addBasicRing(vector<int> unitPath); //add basic ring to network
+    ArenaVector<int> selectUnitPath(int activeUnit); //find path of units to build new ring on
+    void addBasicRing(const ArenaVector<int> &unitPath); //add basic ring to network
+    void reorderNetwork(); //reorder network along hilbert curve and time
+    void compactNetwork(); //remove dead atoms, following ids in trajectory
+    void recordFrame(int nRings); //capture network as trajectory frame
+    void optimiseGlobal(Logfile &logfile); //global geometry optimisation and time
+    void comparePrecision(int acceptedSize, double r01, ArenaVector<int> &sizes, ArenaVector<double> &energies, ArenaVector<int> &sizesSP, ArenaVector<double> &energiesSP); //compare decisions between trial precisions
 
 public:
     //Constructors
@@ -62,12 +85,12 @@ public:
     Simulation(Logfile &logfile);
 
     //set input variables
-    void setIO(string in, string out, Logfile &logfile);
+    void setIO(string in, string out, int format, int trajInterval, Logfile &logfile);
     void setNP(int targRings, int basicMin, int basicMax, string geom, Logfile &logfile);
     void setMC(int seed, double temperature, Logfile &logfile);
-    void setPM(double kMX, double r0MX, double kXX, double a0XX, double kMM, double a0MM, double kLJ, double r0LJ, double kC, double r0C, Logfile &logfile);
-    void setGO(bool global0, bool global1, int it, double ls, double conv, int loc, Logfile &logfile);
-    void setFO(bool bDist, bool rArea, bool bi, bool aClst, Logfile &logfile);
+    void setPM(double kMX, double r0MX, double kXX, double a0XX, double kMM, double a0MM, double kLJ, double r0LJ, double kC, double r0C, string repulsion, double kIX, Logfile &logfile);
+    void setGO(bool global0, bool global1, int it, double ls, double conv, int loc, int threads, int precision, int reorder, Logfile &logfile);
+    void setFO(bool bDist, bool rArea, bool bi, bool aClst, bool lOvlp, Logfile &logfile);
 
     //methods
     void run(Logfile &logfile);
@@ -13,10 +13,14 @@ Simulation<CrdT,NetT>::Simulation(Logfile &logfile) {
 }
 
 template <typename CrdT, typename NetT>
-void Simulation<CrdT,NetT>::setIO(string in, string out, Logfile &logfile) {
+void Simulation<CrdT,NetT>::setIO(string in, string out, int format, int trajInterval, Logfile &logfile) {
     //set io parameters
     prefixIn=in;
     prefixOut=out;
+    networkFormat=format;
+    if(networkFormat<0 || networkFormat>2) logfile.errorlog("Network file format code incorrect","critical");
+    trajectoryInterval=trajInterval;
+    if(trajectoryInterval<0) logfile.errorlog("Trajectory interval cannot be negative","critical");
     logfile.log("Initialised: ","IO","",1,false);
 }
 
@@ -31,6 +35,11 @@ void Simulation<CrdT,NetT>::setNP(int targRings, int basicMin, int basicMax, str
     else if(geom.substr(0,2)=="3D") dimensionality=3;
     else logfile.errorlog("Geometry code incorrect","critical");
     growthGeometry=geom.substr(2,2);
+    //choose shape once, polygon mask read from file alongside input network
+    string maskFilename=prefixIn+"_mask.dat";
+    growthShape.reset(makeShape(growthGeometry,dimensionality,maskFilename));
+    if(!growthShape) logfile.errorlog("Geometry code incorrect or growth mask cannot be read or does not enclose origin","critical");
+    if(growthGeometry=="P") logfile.log("Growth mask read from: ",maskFilename,"",1,false);
     logfile.log("Initialised: ","network properties","",1,false);
 }
 
@@ -41,9 +50,9 @@ void Simulation<CrdT,NetT>::setMC(int seed, double temperature, Logfile &logfile
 }
 
 template <typename CrdT, typename NetT>
-void Simulation<CrdT,NetT>::setPM(double kMX, double r0MX, double kXX, double a0XX, double kMM, double a0MM, double kLJ, double r0LJ, double kC, double r0C, Logfile &logfile) {
+void Simulation<CrdT,NetT>::setPM(double kMX, double r0MX, double kXX, double a0XX, double kMM, double a0MM, double kLJ, double r0LJ, double kC, double r0C, string repulsion, double kIX, Logfile &logfile) {
     //set potential model as M-X, X-X, M-M k and r0 values for harmonics
-    potentialModel.resize(10);
+    potentialModel.resize(11);
     potentialModel[0]=kMX;
     potentialModel[1]=r0MX;
     potentialModel[2]=kXX;
@@ -59,11 +68,19 @@ void Simulation<CrdT,NetT>::setPM(double kMX, double r0MX, double kXX, double a0
     //geometry specific parameters
     potentialModel[8]=kC;
     potentialModel[9]=r0C;
+    //soft penalty on intersecting edges in local optimisation
+    potentialModel[10]=kIX;
+    if(kIX<0.0) logfile.errorlog("Intersection penalty cannot be negative","critical");
+    //repulsion as analytic LJ, spline tabulated from LJ or spline tabulated from file
+    if(repulsion=="spline") repulsionTable.setLJ(kLJ,r0LJ);
+    else if(repulsion!="lj"){
+        if(!repulsionTable.read(repulsion)) logfile.errorlog("Cannot read repulsion table "+repulsion,"critical");
+    }
     logfile.log("Initialised: ","potential model","",1,false);
 }
 
 template <typename CrdT, typename NetT>
-void Simulation<CrdT,NetT>::setGO(bool global0, bool global1, int it, double ls, double conv, int loc, Logfile &logfile) {
+void Simulation<CrdT,NetT>::setGO(bool global0, bool global1, int it, double ls, double conv, int loc, int threads, int precision, int reorder, Logfile &logfile) {
     //set geometery optimisation parameters
     globalPreGO=global0;
     globalPostGO=global1;
@@ -71,16 +88,22 @@ void Simulation<CrdT,NetT>::setGO(bool global0, bool global1, int it, double ls,
     goLineSeachInc=ls;
     goConvergence=conv;
     goLocalExtent=loc;
+    goThreads=threads;
+    goTrialPrecision=precision;
+    if(goTrialPrecision<0 || goTrialPrecision>2) logfile.errorlog("Trial precision code incorrect","critical");
+    goReorderInterval=reorder;
+    if(goReorderInterval<0) logfile.errorlog("Reorder interval cannot be negative","critical");
     logfile.log("Initialised: ","geometry optimisation","",1,false);
 }
 
 template <typename CrdT, typename NetT>
-void Simulation<CrdT,NetT>::setFO(bool bDist, bool rArea, bool bi, bool aClst, Logfile &logfile) {
+void Simulation<CrdT,NetT>::setFO(bool bDist, bool rArea, bool bi, bool aClst, bool lOvlp, Logfile &logfile) {
     //set further options
     fullDistributions=bDist;
     analyseArea=rArea;
     convertToBilayer=bi;
     analyseCluster=aClst;
+    listOverlaps=lOvlp;
     logfile.log("Initialised: ","additional options","",1,false);
 }
 
@@ -106,8 +129,13 @@ void Simulation<CrdT,NetT>::loadNetwork(Logfile &logfile) {
     logfile.log("Intialisation complete","","",0,true);
     if(dimensionality==2) masterNetwork=NetT(prefixIn,logfile);
     else if(dimensionality==3) masterNetwork=NetT(prefixIn,logfile,potentialModel[9]);
-    masterNetwork.setGO(goMaxIterations,goLineSeachInc,goConvergence,goLocalExtent);
-    if(globalPreGO) masterNetwork.geometryOptimiseGlobal(potentialModel);
+    masterNetwork.setGO(goMaxIterations,goLineSeachInc,goConvergence,goLocalExtent,goThreads);
+    masterNetwork.setNetworkFormat(networkFormat);
+    if(!repulsionTable.empty()) masterNetwork.setRepulsionTable(repulsionTable);
+    if(globalPreGO){
+        if(goReorderInterval>0) masterNetwork.reorder();
+        optimiseGlobal(logfile);
+    }
 }
 
 //##### GROW #####
@@ -122,21 +150,41 @@ void Simulation<CrdT,NetT>::growNetwork(Logfile &logfile) {
     energyCutoff=100.0*potentialModel[0];
     goMonitoring=col_vector<int>(3); //number of minimisations, total number of iterations, number of times iteration limit reached
     mcMonitoring=col_vector<double>(nBasicRingSizes);
+    precisionMonitoring=col_vector<int>(3);
+    acceptedDP=col_vector<double>(nBasicRingSizes);
+    acceptedSP=col_vector<double>(nBasicRingSizes);
+    precisionEnergyDiff=0.0;
+    nReorders=0;
+    reorderTime=0.0;
     int nRings=masterNetwork.getNRings();
 
+    //trajectory, starting from network as loaded
+    if(trajectoryInterval>0){
+        string trajectoryFilename=prefixOut+trajectorySuffix;
+        if(!trajectory.open(trajectoryFilename,dimensionality)) logfile.errorlog("Cannot open trajectory file "+trajectoryFilename,"critical");
+        logfile.log("Trajectory written to: ",trajectoryFilename,"",1,false);
+        recordFrame(nRings);
+    }
+
     //main loop
     if(nRings<nTargetRings){//only if network needs growing
         do{
+            masterNetwork.resetArena();
             int activeUnit = selectActiveUnit();
-            vector<int> unitPath = selectUnitPath(activeUnit);
+            ArenaVector<int> unitPath = selectUnitPath(activeUnit);
             addBasicRing(unitPath);
             ++nRings;
+            if(nRings%compactionInterval==0) compactNetwork();
+            if(goReorderInterval>0 && nRings%goReorderInterval==0) reorderNetwork();
+            if(trajectoryInterval>0 && nRings%trajectoryInterval==0) recordFrame(nRings);
             if(nRings%100==0){
                 cout<<nRings<<endl;
                 logfile.log(to_string(nRings)+" rings, time elapsed: ","","sec",2,false);
+                masterNetwork.logMemory(logfile,3,false);
             }
             cout<<nRings<<endl;
             if(killGrowth==1){
+                trajectory.close();
                 masterNetwork.kill(prefixOut,logfile);
                 logfile.errorlog("Growth prematurely killed due to excessive energy","critical");
             }
@@ -145,14 +193,21 @@ void Simulation<CrdT,NetT>::growNetwork(Logfile &logfile) {
                 break;
             }
             else if(killGrowth==3){
+                trajectory.close();
                 masterNetwork.kill(prefixOut,logfile);
                 logfile.errorlog("Growth prematurely killed as no trial rings could be formed","critical");
                 break;
             }
         }while(nRings<nTargetRings);
     }
+    if(trajectoryInterval>0){
+        if(nRings%trajectoryInterval!=0) recordFrame(nRings);
+        if(!trajectory.close()) logfile.errorlog("Trajectory not completely written","write ");
+    }
+    if(goReorderInterval>0 && globalPostGO) reorderNetwork();
     masterNetwork.clean();
     logfile.log("All rings built, time elapsed: ","","sec",2,false);
+    masterNetwork.logMemory(logfile,2,true);
     logfile.log("Network growth complete","","",1,false);
 
     //monitoring results
@@ -174,25 +229,77 @@ void Simulation<CrdT,NetT>::growNetwork(Logfile &logfile) {
     if(double(goMonitoring[2])/double(goMonitoring[0])>0.05) warning=true;
     if(warning) logfile.log("Warning: iteration limit reached frequently","","",2,false);
     else logfile.log("Iteration limit satisfactory","","",2,false);
+    if(goTrialPrecision==2){
+        logfile.log("Trial precision comparison","","",2,false);
+        logfile.log("Agreeing acceptance decisions: ",double(precisionMonitoring[1])/double(precisionMonitoring[0]),"",3,false);
+        logfile.log("Mean trial energy difference: ",precisionEnergyDiff/double(precisionMonitoring[2]),"",3,false);
+        logfile.log("Accepted ring sizes in double and single precision","","",3,false);
+        if(acceptedDP.sum()>0.0) acceptedDP/=acceptedDP.sum();
+        if(acceptedSP.sum()>0.0) acceptedSP/=acceptedSP.sum();
+        logfile.log(ringSizes,3,false);
+        logfile.log(acceptedDP,3,false);
+        logfile.log(acceptedSP,3,false);
+    }
+    if(goReorderInterval>0){
+        logfile.log("Hilbert reordering","","",2,false);
+        logfile.log("Number of reorderings: ",nReorders,"",3,false);
+        logfile.log("Total reordering time (s): ",reorderTime,"",3,false);
+    }
     logfile.log("Monitoring analysis complete","","",1,false);
 
     //global geometry optimisation
     if(globalPostGO){
         logfile.log("Performing global geometry optimisation","","",1,false);
-        masterNetwork.geometryOptimiseGlobal(potentialModel);
+        optimiseGlobal(logfile);
     }
 
     logfile.log("Monte Carlo process complete","","",0,true);
 }
 
 
+template <typename CrdT, typename NetT>
+void Simulation<CrdT,NetT>::reorderNetwork() {
+    //reorder atoms, units and rings of network for memory locality, recording wall time
+    chrono::steady_clock::time_point t0=chrono::steady_clock::now();
+    masterNetwork.reorder();
+    reorderTime+=chrono::duration<double>(chrono::steady_clock::now()-t0).count();
+    ++nReorders;
+    if(trajectory.isOpen()) trajectory.renumbered();
+}
+
+template <typename CrdT, typename NetT>
+void Simulation<CrdT,NetT>::compactNetwork() {
+    //remove dead atoms, passing id changes to trajectory so next frame only lists removed atoms
+    vector<int> updatedAtomIds=masterNetwork.compact();
+    if(trajectory.isOpen()) trajectory.compacted(updatedAtomIds);
+}
+
+template <typename CrdT, typename NetT>
+void Simulation<CrdT,NetT>::recordFrame(int nRings) {
+    //copy network into frame in growth thread, encoded and written in background
+    TrajectoryFrame frame;
+    trajectory.begin(frame);
+    masterNetwork.getFrame(frame);
+    frame.nRingsGrown=nRings;
+    trajectory.push(frame);
+}
+
+template <typename CrdT, typename NetT>
+void Simulation<CrdT,NetT>::optimiseGlobal(Logfile &logfile) {
+    //global geometry optimisation, logging wall time to compare network orderings
+    chrono::steady_clock::time_point t0=chrono::steady_clock::now();
+    masterNetwork.geometryOptimiseGlobal(potentialModel);
+    double dt=chrono::duration<double>(chrono::steady_clock::now()-t0).count();
+    logfile.log("Global optimisation time (s): ",dt,"",2,false);
+}
+
 template <typename CrdT, typename NetT>
 int Simulation<CrdT,NetT>::selectActiveUnit() {
     //find unit within geometrical shape which has dangling bonds
     int activeUnit;
     double regionSize=1.0;
     for(;;){
-        activeUnit=masterNetwork.getActiveUnit(growthGeometry,regionSize);
+        activeUnit=masterNetwork.getActiveUnit(*growthShape,regionSize);
         if(activeUnit==-1) regionSize+=1.0;
         else break;
     }
@@ -200,12 +307,11 @@ int Simulation<CrdT,NetT>::selectActiveUnit() {
 }
 
 template <typename CrdT, typename NetT>
-vector<int> Simulation<CrdT,NetT>::selectUnitPath(int activeUnit) {
+ArenaVector<int> Simulation<CrdT,NetT>::selectUnitPath(int activeUnit) {
     //find both paths which could form new ring, choose one due to some criteria
-    vector<int> unitPath, unitPathL, unitPathR;
-
-    unitPathL=masterNetwork.getBoundarySection(activeUnit,false);
-    unitPathR=masterNetwork.getBoundarySection(activeUnit,true);
+    ArenaVector<int> unitPath(masterNetwork.getArena());
+    ArenaVector<int> unitPathL=masterNetwork.getBoundarySection(activeUnit,false);
+    ArenaVector<int> unitPathR=masterNetwork.getBoundarySection(activeUnit,true);
 
     //for now pick longest if not longer than the basic ring size that can be made
     if(unitPathL.size()>basicMaxSize) unitPath=unitPathR;
@@ -217,18 +323,29 @@ vector<int> Simulation<CrdT,NetT>::selectUnitPath(int activeUnit) {
 }
 
 template <typename CrdT, typename NetT>
-void Simulation<CrdT,NetT>::addBasicRing(vector<int> unitPath) {
+void Simulation<CrdT,NetT>::addBasicRing(const ArenaVector<int> &unitPath) {
     //calculate energy of adding basic rings to network, and select by monte carlo method
 
-    vector<int> trialSizes;
-    vector<double> trialEnergies;
+    Arena &arena=masterNetwork.getArena();
+    ArenaVector<int> trialSizes(arena), trialSizesSP(arena);
+    ArenaVector<double> trialEnergies(arena), trialEnergiesSP(arena);
     bool trialFlag; //if geometrically acceptable ring
     trialSizes.clear();
     trialEnergies.clear();
+    trialSizesSP.clear();
+    trialEnergiesSP.clear();
     for(int i=0, j=basicMinSize; i<nBasicRingSizes; ++i, ++j){
         if(j>=unitPath.size()){
+            //trial ring in single precision for comparison, from same starting coordinates and without affecting growth
+            if(goTrialPrecision==2){
+                trialFlag=masterNetwork.trialRing(j,unitPath,potentialModel,true,true);
+                if(trialFlag){
+                    trialSizesSP.push_back(j);
+                    trialEnergiesSP.push_back(masterNetwork.getEnergy());
+                }
+            }
             //trial ring
-            trialFlag=masterNetwork.trialRing(j,unitPath,potentialModel);
+            trialFlag=masterNetwork.trialRing(j,unitPath,potentialModel,goTrialPrecision==1);
             if(trialFlag) {
                 trialSizes.push_back(j);
                 trialEnergies.push_back(masterNetwork.getEnergy());
@@ -243,13 +360,42 @@ void Simulation<CrdT,NetT>::addBasicRing(vector<int> unitPath) {
     }
     if(trialEnergies.size()==0) killGrowth=3;
     else{
-        int acceptedRing=monteCarlo.metropolis(trialEnergies);
+        double r01=monteCarlo.random();
+        int acceptedRing=monteCarlo.metropolis(trialEnergies,r01);
         if(trialEnergies[acceptedRing]>energyCutoff) killGrowth=1;
         int acceptedSize=trialSizes[acceptedRing];
+        if(goTrialPrecision==2) comparePrecision(acceptedSize,r01,trialSizes,trialEnergies,trialSizesSP,trialEnergiesSP);
         masterNetwork.acceptRing(acceptedSize,unitPath,potentialModel);
         if(masterNetwork.checkGrowth()) killGrowth=2;
     }
 }
+
+template <typename CrdT, typename NetT>
+void Simulation<CrdT,NetT>::comparePrecision(int acceptedSize, double r01, ArenaVector<int> &sizes, ArenaVector<double> &energies,
+                                             ArenaVector<int> &sizesSP, ArenaVector<double> &energiesSP) {
+    //apply metropolis condition to single precision trials with same random number and compare with double precision
+
+    //trial energy differences for rings acceptable in both precisions
+    for(int i=0, j=0; i<sizes.size() && j<sizesSP.size();){
+        if(sizes[i]==sizesSP[j]){
+            precisionEnergyDiff+=fabs(energies[i]-energiesSP[j]);
+            ++precisionMonitoring[2];
+            ++i;
+            ++j;
+        }
+        else if(sizes[i]<sizesSP[j]) ++i;
+        else ++j;
+    }
+
+    //acceptance decisions
+    ++precisionMonitoring[0];
+    acceptedDP[acceptedSize-basicMinSize]+=1.0;
+    if(energiesSP.size()>0){
+        int acceptedSizeSP=sizesSP[monteCarlo.metropolis(energiesSP,r01)];
+        acceptedSP[acceptedSizeSP-basicMinSize]+=1.0;
+        if(acceptedSizeSP==acceptedSize) ++precisionMonitoring[1];
+    }
+}
 //template <typename CrdT, typename NetT>
 //Simulation<CrdT,NetT>::
 //template <typename CrdT, typename NetT>
@@ -263,8 +409,13 @@ void Simulation<CrdT,NetT>::analyseNetwork(Logfile &logfile) {
     logfile.log("Analysing network","","",0,false);
 
     //check geometry
-    masterNetwork.checkOverlap();
+    masterNetwork.checkOverlap(listOverlaps);
     logfile.log("Network checked for unit overlap","","",1,false);
+    if(listOverlaps){
+        vector<int> overlapUnits=masterNetwork.getOverlapUnits();
+        logfile.log("Overlapping unit pairs: ",to_string(overlapUnits.size()/2),"",2,false);
+        for(int i=0; i<overlapUnits.size(); i+=2) logfile.log(vector<int>{overlapUnits[i],overlapUnits[i+1]},3,false);
+    }
 
     //ring statistics
     masterNetwork.calculateRingStatistics();
@@ -281,9 +432,10 @@ void Simulation<CrdT,NetT>::analyseNetwork(Logfile &logfile) {
 
     //percolation
     if(analyseCluster){
-        masterNetwork.calculatePercolation(growthGeometry);
+        masterNetwork.calculatePercolation(*growthShape);
         logfile.log("Analysing clusters and percolation","","",1,false);
     }
+    masterNetwork.logMemory(logfile,1,true);
 
     logfile.log("Analysis complete","","",0,true);
 }
@@ -0,0 +1,55 @@
+//Uniform hashed grid over atom positions, for finding nearby atoms in time proportional to local density
+//Only cells that have held atoms are stored, so for 3DS the cells follow the sphere surface rather than filling its volume
+#ifndef MX2_SPATIALGRID_H
+#define MX2_SPATIALGRID_H
+
+#include <iostream>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+template <typename CrdT>
+class SpatialGrid {
+    //cells of given size keyed by packed integer cell indices, atoms identified by id into coordinate buffer
+
+private:
+    static const int dim=CrdT::dim; //dimensions
+    double cellSize, invCellSize; //length of cell side and inverse
+    unordered_map<unsigned long long, int> cells; //first atom in each cell that has held atoms, -1 if empty
+    vector<unsigned long long> atomCells; //cell key of each atom
+    vector<int> atomNext; //next atom in same cell, -1 at end, so cells hold no storage of their own
+
+    void cellIndex(const double *c, long long *idx); //integer cell indices of point
+    unsigned long long cellKey(const long long *idx); //pack cell indices into key
+    void addToCell(int id, unsigned long long key); //add atom id to cell
+    void removeFromCell(int id, unsigned long long key); //remove atom id from cell
+    template <typename Test> void search(const double *lo, const double *hi, vector<int> &ids, Test test); //atoms in cells overlapping box passing test
+
+public:
+    //constructors
+    SpatialGrid();
+
+    //setters
+    void setCellSize(double size);
+
+    //maintenance
+    void build(const vector<double> &crds); //rebuild from all coordinates
+    void build(const double *crds, int n); //rebuild from coordinates of n atoms
+    void insert(int id, const double *c); //add atom, ids must be added in order
+    void remove(int id); //remove atom with highest id
+    void update(int id, const double *c); //move atom to new position
+    size_t memory() const; //approximate bytes held, including hash table overhead
+
+    //queries, ids returned in ascending order
+    void radius(const vector<double> &crds, const double *c, double r, vector<int> &ids); //atoms within radius of point
+    void radius(const double *crds, const double *c, double r, vector<int> &ids);
+    void box(const vector<double> &crds, const double *lo, const double *hi, vector<int> &ids); //atoms within axis aligned box
+    void segment(const vector<double> &crds, const double *a, const double *b, double r, vector<int> &ids); //atoms within distance of line segment
+};
+
+#include "spatialGrid.tpp"
+
+#endif //MX2_SPATIALGRID_H
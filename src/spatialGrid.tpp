@@ -0,0 +1,196 @@
+#include "spatialGrid.h"
+
+//##### CONSTRUCTORS #####
+template <typename CrdT>
+SpatialGrid<CrdT>::SpatialGrid() {
+    //default constructor, unit cells
+    cellSize=1.0;
+    invCellSize=1.0;
+}
+
+//##### SETTERS #####
+template <typename CrdT>
+void SpatialGrid<CrdT>::setCellSize(double size) {
+    //set cell size, grid must be rebuilt after
+    cellSize=size;
+    invCellSize=1.0/size;
+}
+
+//##### CELLS #####
+template <typename CrdT>
+inline void SpatialGrid<CrdT>::cellIndex(const double *c, long long *idx) {
+    //integer cell indices of point
+    for(int i=0; i<dim; ++i) idx[i]=(long long)floor(c[i]*invCellSize);
+}
+
+template <typename CrdT>
+inline unsigned long long SpatialGrid<CrdT>::cellKey(const long long *idx) {
+    //pack offset cell indices into 21 bits per dimension
+    unsigned long long key=0;
+    for(int i=0; i<dim; ++i) key=(key<<21)|((unsigned long long)(idx[i]+(1<<20))&0x1FFFFF);
+    return key;
+}
+
+template <typename CrdT>
+void SpatialGrid<CrdT>::addToCell(int id, unsigned long long key) {
+    //link atom id at head of cell, only cells reached for first time allocate
+    typename unordered_map<unsigned long long, int>::iterator cell=cells.find(key);
+    if(cell==cells.end()) cell=cells.insert(make_pair(key,-1)).first;
+    atomNext[id]=cell->second;
+    cell->second=id;
+}
+
+template <typename CrdT>
+void SpatialGrid<CrdT>::removeFromCell(int id, unsigned long long key) {
+    //unlink atom id from cell, emptied cells kept so atoms moving back do not reallocate
+    int *link=&cells.find(key)->second;
+    while(*link!=id) link=&atomNext[*link];
+    *link=atomNext[id];
+}
+
+//##### MAINTENANCE #####
+template <typename CrdT>
+void SpatialGrid<CrdT>::build(const vector<double> &crds) {
+    //rebuild grid from all coordinates
+    build(crds.data(),crds.size()/dim);
+}
+
+template <typename CrdT>
+void SpatialGrid<CrdT>::build(const double *crds, int n) {
+    //rebuild grid from coordinates of n atoms, reusing cell storage
+    for(typename unordered_map<unsigned long long, int>::iterator cell=cells.begin(); cell!=cells.end(); ++cell) cell->second=-1;
+    atomCells.clear();
+    atomNext.clear();
+    atomCells.reserve(n);
+    atomNext.reserve(n);
+    for(int i=0; i<n; ++i) insert(i,&crds[dim*i]);
+}
+
+template <typename CrdT>
+void SpatialGrid<CrdT>::insert(int id, const double *c) {
+    //add atom to cell containing position
+    long long idx[dim];
+    cellIndex(c,idx);
+    unsigned long long key=cellKey(idx);
+    atomCells.push_back(key);
+    atomNext.push_back(-1);
+    addToCell(id,key);
+}
+
+template <typename CrdT>
+void SpatialGrid<CrdT>::remove(int id) {
+    //remove atom with highest id
+    removeFromCell(id,atomCells[id]);
+    atomCells.pop_back();
+    atomNext.pop_back();
+}
+
+template <typename CrdT>
+void SpatialGrid<CrdT>::update(int id, const double *c) {
+    //move atom between cells if position has left its cell
+    long long idx[dim];
+    cellIndex(c,idx);
+    unsigned long long key=cellKey(idx);
+    if(key==atomCells[id]) return;
+    removeFromCell(id,atomCells[id]);
+    addToCell(id,key);
+    atomCells[id]=key;
+}
+
+template <typename CrdT>
+size_t SpatialGrid<CrdT>::memory() const {
+    //bytes in atom keys and links, with nodes and bucket pointers of hash table
+    size_t bytes=atomCells.capacity()*sizeof(unsigned long long)+atomNext.capacity()*sizeof(int)+cells.bucket_count()*sizeof(void*);
+    bytes+=cells.size()*(sizeof(void*)+sizeof(unsigned long long)+sizeof(int));
+    return bytes;
+}
+
+//##### QUERIES #####
+template <typename CrdT>
+template <typename Test>
+void SpatialGrid<CrdT>::search(const double *lo, const double *hi, vector<int> &ids, Test test) {
+    //loop over cells overlapping box and collect atoms passing test, sorted by id
+    ids.clear();
+    long long idxLo[dim], idxHi[dim], idx[dim];
+    cellIndex(lo,idxLo);
+    cellIndex(hi,idxHi);
+    for(int i=0; i<dim; ++i) idx[i]=idxLo[i];
+    for(;;){
+        typename unordered_map<unsigned long long, int>::iterator cell=cells.find(cellKey(idx));
+        if(cell!=cells.end()){
+            for(int id=cell->second; id!=-1; id=atomNext[id]) if(test(id)) ids.push_back(id);
+        }
+        //advance to next cell, odometer style
+        int i=0;
+        for(; i<dim; ++i){
+            if(idx[i]<idxHi[i]){
+                ++idx[i];
+                break;
+            }
+            idx[i]=idxLo[i];
+        }
+        if(i==dim) break;
+    }
+    sort(ids.begin(),ids.end());
+}
+
+template <typename CrdT>
+void SpatialGrid<CrdT>::radius(const vector<double> &crds, const double *c, double r, vector<int> &ids) {
+    //atoms within radius of point
+    radius(crds.data(),c,r,ids);
+}
+
+template <typename CrdT>
+void SpatialGrid<CrdT>::radius(const double *crds, const double *c, double r, vector<int> &ids) {
+    //atoms within radius of point, coordinates from raw buffer
+    double lo[dim], hi[dim], rSq=r*r;
+    for(int i=0; i<dim; ++i){
+        lo[i]=c[i]-r;
+        hi[i]=c[i]+r;
+    }
+    search(lo,hi,ids,[&](int id){
+        double dSq=0.0;
+        for(int i=0; i<dim; ++i){
+            double d=crds[dim*id+i]-c[i];
+            dSq+=d*d;
+        }
+        return dSq<=rSq;
+    });
+}
+
+template <typename CrdT>
+void SpatialGrid<CrdT>::box(const vector<double> &crds, const double *lo, const double *hi, vector<int> &ids) {
+    //atoms within axis aligned box
+    search(lo,hi,ids,[&](int id){
+        for(int i=0; i<dim; ++i){
+            double x=crds[dim*id+i];
+            if(x<lo[i] || x>hi[i]) return false;
+        }
+        return true;
+    });
+}
+
+template <typename CrdT>
+void SpatialGrid<CrdT>::segment(const vector<double> &crds, const double *a, const double *b, double r, vector<int> &ids) {
+    //atoms within distance of line segment between a and b
+    double lo[dim], hi[dim], ab[dim], abSq=0.0, rSq=r*r;
+    for(int i=0; i<dim; ++i){
+        lo[i]=min(a[i],b[i])-r;
+        hi[i]=max(a[i],b[i])+r;
+        ab[i]=b[i]-a[i];
+        abSq+=ab[i]*ab[i];
+    }
+    search(lo,hi,ids,[&](int id){
+        //closest point on segment
+        const double *p=&crds[dim*id];
+        double t=0.0;
+        for(int i=0; i<dim; ++i) t+=(p[i]-a[i])*ab[i];
+        t=(abSq>0.0) ? max(0.0,min(1.0,t/abSq)) : 0.0;
+        double dSq=0.0;
+        for(int i=0; i<dim; ++i){
+            double d=p[i]-(a[i]+t*ab[i]);
+            dSq+=d*d;
+        }
+        return dSq<=rSq;
+    });
+}
@@ -0,0 +1,384 @@
+#include "textIO.h"
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define MX2_MMAP
+#endif
+
+//##### MAPPED FILE #####
+MappedFile::MappedFile() {
+    //default constructor
+    bytes=nullptr;
+    length=0;
+    mapping=nullptr;
+}
+
+MappedFile::~MappedFile() {
+    //release mapping
+    close();
+}
+
+void MappedFile::close() {
+    //unmap or free contents
+#ifdef MX2_MMAP
+    if(mapping!=nullptr) munmap(mapping,length);
+#endif
+    mapping=nullptr;
+    bytes=nullptr;
+    length=0;
+    buffer.clear();
+}
+
+bool MappedFile::open(string filename) {
+    //map whole file read only, falling back to single read if mapping unavailable or file empty
+    close();
+#ifdef MX2_MMAP
+    int fd=::open(filename.c_str(),O_RDONLY);
+    if(fd<0) return false;
+    struct stat info;
+    if(fstat(fd,&info)==0 && info.st_size>0){
+        void *m=mmap(nullptr,info.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+        if(m!=MAP_FAILED){
+            ::close(fd);
+            mapping=m;
+            length=info.st_size;
+            bytes=static_cast<const char*>(m);
+            madvise(m,length,MADV_SEQUENTIAL);
+            return true;
+        }
+    }
+    ::close(fd);
+#endif
+    ifstream file(filename, ios::in|ios::binary|ios::ate);
+    if(!file.good()) return false;
+    streamsize size=file.tellg();
+    if(size<0) return false;
+    file.seekg(0,ios::beg);
+    buffer.resize(size);
+    if(size>0) file.read(buffer.data(),size);
+    bytes=buffer.data();
+    length=size;
+    return !file.fail();
+}
+
+const char* MappedFile::begin() const {
+    //first byte
+    return bytes;
+}
+
+const char* MappedFile::end() const {
+    //one past last byte
+    return bytes+length;
+}
+
+//##### LINE INDEX #####
+inline bool isSpace(char c) {
+    //separator within line
+    return c==' ' || c=='\t' || c=='\r' || c=='\v' || c=='\f';
+}
+
+void LineIndex::build(const char *begin, const char *end) {
+    //split at newlines, skipping blank lines
+    starts.clear();
+    ends.clear();
+    numbers.clear();
+    const char *p=begin, *e, *q;
+    int number=1;
+    while(p<end){
+        e=static_cast<const char*>(memchr(p,'\n',end-p));
+        if(e==nullptr) e=end;
+        for(q=p; q<e && isSpace(*q); ++q);
+        if(q<e){
+            starts.push_back(p);
+            ends.push_back(e);
+            numbers.push_back(number);
+        }
+        p=e+1;
+        ++number;
+    }
+}
+
+int LineIndex::size() const {
+    //number of non-blank lines
+    return starts.size();
+}
+
+//##### NUMBER PARSING #####
+static const double exactPowersOfTen[]={1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9,1e10,1e11,1e12,1e13,1e14,1e15,1e16,1e17,1e18,1e19,1e20,1e21,1e22};
+
+int parseInts(const char *p, const char *end, int *values, int maxValues) {
+    //optional sign then digits, tokens separated by whitespace
+    int n=0;
+    while(n<maxValues){
+        while(p<end && isSpace(*p)) ++p;
+        if(p==end) break;
+        bool negative=false;
+        if(*p=='-' || *p=='+'){
+            negative=(*p=='-');
+            ++p;
+        }
+        if(p==end || *p<'0' || *p>'9') return -1;
+        long long v=0;
+        while(p<end && *p>='0' && *p<='9'){
+            v=10*v+(*p-'0');
+            if(v>2147483648LL) return -1;
+            ++p;
+        }
+        if(p<end && !isSpace(*p)) return -1;
+        v=negative ? -v : v;
+        if(v>2147483647LL) return -1;
+        values[n++]=int(v);
+    }
+    return n;
+}
+
+int parseDoubles(const char *p, const char *end, double *values, int maxValues) {
+    //decimal with up to 15 significant digits and exponent within exact powers of ten converted by single correctly rounded
+    //multiplication or division, so matches strtod, any other token copied out and passed to strtod
+    int n=0;
+    char token[64];
+    while(n<maxValues){
+        while(p<end && isSpace(*p)) ++p;
+        if(p==end) break;
+        const char *t=p;
+        bool negative=false;
+        if(*p=='-' || *p=='+'){
+            negative=(*p=='-');
+            ++p;
+        }
+        long long mantissa=0;
+        int digits=0, scale=0, nDigits=0;
+        bool fast=true;
+        while(p<end && *p>='0' && *p<='9'){
+            if(mantissa!=0 || *p!='0') ++digits;
+            mantissa=10*mantissa+(*p-'0');
+            ++nDigits;
+            if(digits>15){
+                fast=false;
+                break;
+            }
+            ++p;
+        }
+        if(fast && p<end && *p=='.'){
+            ++p;
+            while(p<end && *p>='0' && *p<='9'){
+                if(mantissa!=0 || *p!='0') ++digits;
+                mantissa=10*mantissa+(*p-'0');
+                ++nDigits;
+                --scale;
+                if(digits>15){
+                    fast=false;
+                    break;
+                }
+                ++p;
+            }
+        }
+        if(fast && p<end && (*p=='e' || *p=='E')) fast=false;
+        if(fast && nDigits>0 && scale>=-22 && (p==end || isSpace(*p))){
+            double v=double(mantissa);
+            if(scale<0) v/=exactPowersOfTen[-scale];
+            values[n++]=negative ? -v : v;
+            continue;
+        }
+
+        //general token
+        const char *e=t;
+        while(e<end && !isSpace(*e)) ++e;
+        if(e-t>=int(sizeof(token))) return -1;
+        memcpy(token,t,e-t);
+        token[e-t]='\0';
+        char *stop;
+        double v=strtod(token,&stop);
+        if(stop!=token+(e-t)) return -1;
+        values[n++]=v;
+        p=e;
+    }
+    return n;
+}
+
+int countTokens(const char *p, const char *end) {
+    //runs of non-whitespace characters
+    int n=0;
+    while(p<end){
+        while(p<end && isSpace(*p)) ++p;
+        if(p==end) break;
+        ++n;
+        while(p<end && !isSpace(*p)) ++p;
+    }
+    return n;
+}
+
+//##### TEXT WRITER #####
+TextWriter::TextWriter(string filename, size_t capacity) {
+    //open file for writing, truncating any contents
+    file=fopen(filename.c_str(),"w");
+    buffer.resize(max(capacity,size_t(256)));
+    used=0;
+    fixedFormat=false;
+    precision=6;
+    failed=(file==nullptr);
+}
+
+TextWriter::~TextWriter() {
+    //flush remaining output
+    close();
+}
+
+void TextWriter::setFixed(int digits) {
+    //fixed format
+    fixedFormat=true;
+    precision=digits;
+}
+
+void TextWriter::setGeneral(int digits) {
+    //general format
+    fixedFormat=false;
+    precision=digits;
+}
+
+void TextWriter::flush() {
+    //single write of pending bytes
+    if(used==0) return;
+    if(file==nullptr || fwrite(buffer.data(),1,used,file)!=used) failed=true;
+    used=0;
+}
+
+void TextWriter::reserve(size_t n) {
+    //make room for n bytes, enlarging buffer for oversized fields
+    if(used+n>buffer.size()) flush();
+    if(n>buffer.size()) buffer.resize(n);
+}
+
+void TextWriter::pad(size_t start, int width) {
+    //spaces after field, as with setw and left
+    int length=used-start;
+    if(length>=width) return;
+    reserve(width-length);
+    memset(&buffer[used],' ',width-length);
+    used+=width-length;
+}
+
+TextWriter& TextWriter::putUnsigned(unsigned long long value, int width) {
+    //digits generated in reverse then copied
+    char digits[24];
+    int n=0;
+    do{
+        digits[n++]=char('0'+value%10);
+        value/=10;
+    } while(value>0);
+    reserve(n+width);
+    size_t start=used;
+    while(n>0) buffer[used++]=digits[--n];
+    pad(start,width);
+    return *this;
+}
+
+TextWriter& TextWriter::putSigned(long long value, int width) {
+    //sign then magnitude, field width includes sign
+    if(value>=0) return putUnsigned(value,width);
+    reserve(1);
+    buffer[used++]='-';
+    return putUnsigned(0ULL-(unsigned long long)value,width-1);
+}
+
+TextWriter& TextWriter::put(int value, int width) {
+    return putSigned(value,width);
+}
+
+TextWriter& TextWriter::put(long value, int width) {
+    return putSigned(value,width);
+}
+
+TextWriter& TextWriter::put(long long value, int width) {
+    return putSigned(value,width);
+}
+
+TextWriter& TextWriter::put(unsigned int value, int width) {
+    return putUnsigned(value,width);
+}
+
+TextWriter& TextWriter::put(unsigned long value, int width) {
+    return putUnsigned(value,width);
+}
+
+TextWriter& TextWriter::put(unsigned long long value, int width) {
+    return putUnsigned(value,width);
+}
+
+TextWriter& TextWriter::put(double value, int width) {
+    //fixed values rounded as scaled integers where rounding unambiguous, ties and general format through snprintf
+    reserve(32+width);
+    size_t start=used;
+    if(fixedFormat && precision>=0 && precision<=9 && isfinite(value)){
+        double scaled=fabs(value)*exactPowersOfTen[precision];
+        if(scaled<4.0e15){
+            double whole=floor(scaled);
+            double fraction=scaled-whole;
+            if(fabs(fraction-0.5)>scaled*4.5e-16+1e-300){
+                unsigned long long digits=(unsigned long long)whole+(fraction>0.5 ? 1 : 0);
+                unsigned long long scale=(unsigned long long)exactPowersOfTen[precision];
+                if(signbit(value)) buffer[used++]='-';
+                putUnsigned(digits/scale,0);
+                if(precision>0){
+                    buffer[used++]='.';
+                    unsigned long long rest=digits%scale;
+                    for(int i=precision-1; i>=0; --i){
+                        buffer[used+i]=char('0'+rest%10);
+                        rest/=10;
+                    }
+                    used+=precision;
+                }
+                pad(start,width);
+                return *this;
+            }
+        }
+    }
+    int n=snprintf(&buffer[used],buffer.size()-used,fixedFormat ? "%.*f" : "%.*g",precision,value);
+    if(n>=int(buffer.size()-used)){
+        reserve(n+1);
+        start=used;
+        n=snprintf(&buffer[used],buffer.size()-used,fixedFormat ? "%.*f" : "%.*g",precision,value);
+    }
+    used+=n;
+    pad(start,width);
+    return *this;
+}
+
+TextWriter& TextWriter::put(const char *value, int width) {
+    //copy characters
+    size_t n=strlen(value);
+    reserve(n);
+    size_t start=used;
+    memcpy(&buffer[used],value,n);
+    used+=n;
+    pad(start,width);
+    return *this;
+}
+
+TextWriter& TextWriter::put(const string &value, int width) {
+    return put(value.c_str(),width);
+}
+
+TextWriter& TextWriter::endLine() {
+    //new line without flush
+    reserve(1);
+    buffer[used++]='\n';
+    return *this;
+}
+
+bool TextWriter::good() const {
+    //no failures so far
+    return !failed;
+}
+
+bool TextWriter::close() {
+    //flush and release file
+    flush();
+    if(file!=nullptr){
+        if(fclose(file)!=0) failed=true;
+        file=nullptr;
+    }
+    return !failed;
+}
@@ -0,0 +1,144 @@
+//Fast reading of whitespace separated numeric text files, mapped into memory and split into lines for parallel parsing.
+//Numbers parsed in place without streams, doubles with short mantissas converted exactly, others passed to strtod.
+//Fast writing through a large buffer flushed only when full, formatting byte identical to streams with setw and left.
+#ifndef MX2_TEXTIO_H
+#define MX2_TEXTIO_H
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include "col_vector.h"
+
+using namespace std;
+
+class MappedFile {
+    //read only view of whole file, memory mapped where supported, otherwise read into buffer
+
+private:
+    const char *bytes; //start of contents
+    size_t length; //number of bytes
+    void *mapping; //mapped region, null if not mapped
+    vector<char> buffer; //contents if not mapped
+
+    void close(); //release mapping
+
+public:
+    //constructors, destructor
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile&)=delete;
+    MappedFile& operator=(const MappedFile&)=delete;
+
+    //methods
+    bool open(string filename); //map file, false if cannot open
+    const char* begin() const;
+    const char* end() const;
+};
+
+struct LineIndex {
+    //start and end of each line holding non-whitespace characters, so lines can be parsed independently
+
+    vector<const char*> starts, ends;
+    vector<int> numbers; //line number in file of each line, from 1, for error messages
+
+    //methods
+    void build(const char *begin, const char *end); //find lines in range
+    int size() const; //number of lines
+};
+
+int parseInts(const char *p, const char *end, int *values, int maxValues); //parse up to max integers from range, number parsed or -1 if malformed
+int parseDoubles(const char *p, const char *end, double *values, int maxValues); //parse up to max doubles from range, number parsed or -1 if malformed
+int countTokens(const char *p, const char *end); //number of whitespace separated tokens in range
+
+class TextWriter {
+    //buffered file writer, values left justified in fields as with setw and left
+    //doubles written fixed or general to set precision, as with fixed and setprecision, general by default
+
+private:
+    FILE *file; //output file, null if not open
+    vector<char> buffer; //pending output
+    size_t used; //bytes of buffer pending
+    bool fixedFormat; //fixed or general floating point format
+    int precision; //digits after point if fixed, significant digits if general
+    bool failed; //any write failed
+
+    void reserve(size_t n); //flush if fewer than n bytes free
+    void flush(); //write pending output to file
+    void pad(size_t start, int width); //pad field begun at start to width
+    TextWriter& putSigned(long long value, int width);
+    TextWriter& putUnsigned(unsigned long long value, int width);
+
+public:
+    //constructors, destructor
+    TextWriter(string filename, size_t capacity=1<<20);
+    ~TextWriter();
+    TextWriter(const TextWriter&)=delete;
+    TextWriter& operator=(const TextWriter&)=delete;
+
+    //set up
+    void setFixed(int digits); //fixed format with digits after point
+    void setGeneral(int digits=6); //general format with significant digits
+
+    //methods
+    TextWriter& put(int value, int width=0);
+    TextWriter& put(long value, int width=0);
+    TextWriter& put(long long value, int width=0);
+    TextWriter& put(unsigned int value, int width=0);
+    TextWriter& put(unsigned long value, int width=0);
+    TextWriter& put(unsigned long long value, int width=0);
+    TextWriter& put(double value, int width=0);
+    TextWriter& put(const char *value, int width=0);
+    TextWriter& put(const string &value, int width=0);
+    TextWriter& endLine();
+    bool good() const; //opened and all writes succeeded
+    bool close(); //flush and close file, false if any write failed
+};
+
+//#### writing to buffered file, as easyIO ####
+template <typename T>
+void writeFileValue(TextWriter &file, T value, bool endLine, int width=10){
+    //write single value to file
+    file.put(value,width);
+    if(endLine) file.endLine();
+}
+template <typename S, typename T>
+void writeFileValue(TextWriter &file, S value0, T value1, int width=20){
+    //write two values to file
+    file.put(value0,width).put(value1,width).endLine();
+}
+template <typename S, typename T, typename U>
+void writeFileValue(TextWriter &file, S value0, T value1, U value2, int width=20){
+    //write three values to file
+    file.put(value0,width).put(value1,width).put(value2,width).endLine();
+}
+template <typename T>
+void writeFileVector(TextWriter &file, const vector<T> &values, int width=10){
+    //write vector of values to file
+    for(int i=0; i<values.size(); ++i) file.put(values[i],width);
+    file.endLine();
+}
+template <typename T>
+void writeFileVector(TextWriter &file, col_vector<T> &values, int width=10){
+    //write vector of values to file
+    for(int i=0; i<values.n; ++i) file.put(values[i],width);
+    file.endLine();
+}
+template <typename T>
+void writeFileVectorTranspose(TextWriter &file, const vector<T> &values, int width=10){
+    //write vector of values to file
+    for(int i=0; i<values.size(); ++i) file.put(values[i],width).endLine();
+}
+template <typename T>
+void writeFileArray(TextWriter &file, T values, int n, bool endLine, int width=10){
+    //write array of values to file
+    for(int i=0; i<n; ++i) file.put(values[i],width);
+    if(endLine) file.endLine();
+}
+
+#endif //MX2_TEXTIO_H
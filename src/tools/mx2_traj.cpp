@@ -0,0 +1,87 @@
+//Growth trajectory reader: lists frames of trajectory, or reconstructs one frame and writes its xyz, unit and ring files.
+//Atoms not in any unit are dead atoms awaiting compaction, so are left out and ids renumbered.
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <iomanip>
+#include "../trajectory.h"
+#include "../textIO.h"
+
+using namespace std;
+
+int main(int argc, char *argv[]){
+
+    if(argc!=2 && argc!=4){
+        cout<<"Usage: mx2_traj.x <trajectory file>                          list frames"<<endl;
+        cout<<"       mx2_traj.x <trajectory file> <frame> <output prefix>  write frame, -1 for last"<<endl;
+        return 1;
+    }
+    TrajectoryReader trajectory;
+    if(!trajectory.open(argv[1])){
+        cout<<"Cannot read trajectory "<<argv[1]<<endl;
+        return 1;
+    }
+    int dim=trajectory.dimensionality();
+    TrajectoryFrame frame;
+
+    //list frames, replaying in order so each frame applied once
+    if(argc==2){
+        cout<<setw(10)<<left<<"frame"<<setw(10)<<left<<"rings"<<setw(10)<<left<<"atoms"<<setw(10)<<left<<"units"<<"key"<<endl;
+        for(int f=0; f<trajectory.nFrames(); ++f){
+            if(!trajectory.frame(f,frame)){
+                cout<<"Frame "<<f<<" malformed"<<endl;
+                return 1;
+            }
+            cout<<setw(10)<<left<<f<<setw(10)<<left<<frame.nRingsGrown<<setw(10)<<left<<frame.nAtoms(dim)
+                <<setw(10)<<left<<frame.nUnits()<<trajectory.isKey(f)<<endl;
+        }
+        return 0;
+    }
+
+    //reconstruct frame
+    int f=atoi(argv[2]);
+    if(f<0) f+=trajectory.nFrames();
+    if(!trajectory.frame(f,frame)){
+        cout<<"Cannot reconstruct frame "<<argv[2]<<endl;
+        return 1;
+    }
+
+    //renumber atoms in units
+    int nAtoms=frame.nAtoms(dim), nUnits=frame.nUnits();
+    vector<int> atomIds(nAtoms,-1);
+    for(int i=0; i<4*nUnits; ++i) atomIds[frame.unitAtoms[i]]=0;
+    int nLive=0;
+    for(int i=0; i<nAtoms; ++i) if(atomIds[i]==0) atomIds[i]=nLive++;
+
+    //write element and x,y,z of live atoms, z zero for planar network
+    string prefix=argv[3];
+    TextWriter xyzFile(prefix+".xyz");
+    xyzFile.setFixed(6);
+    writeFileValue(xyzFile,nLive,true);
+    writeFileValue(xyzFile," ",true);
+    for(int i=0; i<nAtoms; ++i){
+        if(atomIds[i]<0) continue;
+        xyzFile.put(frame.elements[i]).put("  ").put(frame.crds[dim*i]).put("  ").put(frame.crds[dim*i+1]).put(" ");
+        xyzFile.put(dim==3 ? frame.crds[dim*i+2] : 0.0).endLine();
+    }
+
+    //write unit atom ids and ring unit ids as network files
+    TextWriter unitFile(prefix+"_units.out");
+    for(int i=0; i<nUnits; ++i){
+        for(int j=0; j<4; ++j) unitFile.put(atomIds[frame.unitAtoms[4*i+j]],10);
+        unitFile.endLine();
+    }
+    TextWriter ringFile(prefix+"_rings.out");
+    for(int i=0; i<frame.nRings(); ++i){
+        for(int j=frame.ringOffsets[i]; j<frame.ringOffsets[i+1]; ++j) ringFile.put(frame.ringUnits[j],10);
+        ringFile.endLine();
+    }
+    bool written=xyzFile.close() && unitFile.close() && ringFile.close();
+    if(!written){
+        cout<<"Cannot write frame to "<<prefix<<endl;
+        return 1;
+    }
+    cout<<"Frame "<<f<<" ("<<frame.nRingsGrown<<" rings) written to "<<prefix<<".xyz, "<<prefix<<"_units.out, "<<prefix<<"_rings.out"<<endl;
+    return 0;
+}
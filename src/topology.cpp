@@ -0,0 +1,62 @@
+#include "topology.h"
+
+//##### ADJACENCY CSR #####
+void AdjacencyCSR::reset(int nNodes, int nCnxs) {
+    //clear and reserve space for given number of nodes and connections
+    offsets.clear();
+    ids.clear();
+    offsets.reserve(nNodes+1);
+    ids.reserve(nCnxs);
+    offsets.push_back(0);
+}
+
+size_t AdjacencyCSR::memory() const {
+    //bytes held by offsets and connections
+    return (offsets.capacity()+ids.capacity())*sizeof(int);
+}
+
+//##### TOPOLOGY #####
+Topology::Topology() {
+    //default constructor
+    nUnits=0;
+    nRings=0;
+}
+
+void Topology::build(vector<Unit> &units, vector<Ring> &rings) {
+    //take snapshot of unit and ring connectivity
+
+    nUnits=units.size();
+    nRings=rings.size();
+
+    //unit connections
+    unitAtomM.resize(nUnits);
+    unitAtomsX.reset(nUnits,3*nUnits);
+    unitUnits.reset(nUnits,3*nUnits);
+    unitRings.reset(nUnits,3*nUnits);
+    for(int i=0; i<nUnits; ++i){
+        unitAtomM[i]=units[i].atomM;
+        unitAtomsX.append(units[i].atomsX);
+        unitUnits.append(units[i].units);
+        unitRings.append(units[i].rings);
+    }
+
+    //ring connections
+    int nRingCnxs=0;
+    for(int i=0; i<nRings; ++i) nRingCnxs+=rings[i].units.n;
+    ringUnits.reset(nRings,nRingCnxs);
+    ringRings.reset(nRings,nRingCnxs);
+    ringBulk.resize(nRings);
+    for(int i=0; i<nRings; ++i){
+        ringUnits.append(rings[i].units);
+        ringRings.append(rings[i].rings);
+        ringBulk[i]=rings[i].rings.full();
+    }
+}
+
+size_t Topology::memory() const {
+    //bytes held by all snapshot arrays
+    size_t bytes=unitAtomM.capacity()*sizeof(int)+ringBulk.capacity()/8;
+    bytes+=unitAtomsX.memory()+unitUnits.memory()+unitRings.memory();
+    bytes+=ringUnits.memory()+ringRings.memory();
+    return bytes;
+}
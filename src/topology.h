@@ -0,0 +1,68 @@
+//Flat snapshot of network connectivity, for analysis and writing
+#ifndef MX2_TOPOLOGY_H
+#define MX2_TOPOLOGY_H
+
+#include <iostream>
+#include <vector>
+#include "connector.h"
+#include "unit.h"
+#include "ring.h"
+
+using namespace std;
+
+struct AdjacencyCSR {
+    //compressed sparse row adjacency, connections of node i held contiguously in ids[offsets[i]] to ids[offsets[i+1]-1]
+
+    vector<int> offsets; //start of connections for each node, with final end
+    vector<int> ids; //all connections
+
+    //methods
+    void reset(int nNodes, int nCnxs); //clear and reserve
+    template <typename Cnx> void append(const Cnx &cnx); //add connections of next node
+    int size(int i) const; //number of connections of node
+    int operator()(int i, int j) const; //jth connection of node
+    const int* begin(int i) const; //pointer to connections of node
+    size_t memory() const; //bytes held
+};
+
+struct Topology {
+    //unit and ring connectivity in contiguous arrays
+
+    int nUnits, nRings; //number of units and rings
+    vector<int> unitAtomM; //metal atom of each unit
+    AdjacencyCSR unitAtomsX, unitUnits, unitRings; //unit connections to x atoms, units and rings
+    AdjacencyCSR ringUnits, ringRings; //ring connections to units and rings
+    vector<bool> ringBulk; //rings fully surrounded by other rings
+
+    //constructors
+    Topology();
+
+    //methods
+    void build(vector<Unit> &units, vector<Ring> &rings); //take snapshot of network connectivity
+    size_t memory() const; //bytes held
+};
+
+//##### ADJACENCY CSR INLINE #####
+template <typename Cnx>
+inline void AdjacencyCSR::append(const Cnx &cnx) {
+    //add connections of next node
+    for(int i=0; i<cnx.n; ++i) ids.push_back(cnx.ids[i]);
+    offsets.push_back(ids.size());
+}
+
+inline int AdjacencyCSR::size(int i) const {
+    //number of connections of node
+    return offsets[i+1]-offsets[i];
+}
+
+inline int AdjacencyCSR::operator()(int i, int j) const {
+    //jth connection of node
+    return ids[offsets[i]+j];
+}
+
+inline const int* AdjacencyCSR::begin(int i) const {
+    //pointer to connections of node
+    return ids.data()+offsets[i];
+}
+
+#endif //MX2_TOPOLOGY_H
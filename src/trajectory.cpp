@@ -0,0 +1,477 @@
+#include "trajectory.h"
+
+//##### VARIABLE LENGTH INTEGERS #####
+//seven bits per byte, high bit set while more follow, signed values zigzag mapped so small magnitudes are short
+static void putVarint(vector<char> &buffer, unsigned long long value) {
+    //low groups first
+    while(value>=0x80){
+        buffer.push_back(char((value&0x7F)|0x80));
+        value>>=7;
+    }
+    buffer.push_back(char(value));
+}
+
+static void putZigzag(vector<char> &buffer, long long value) {
+    //interleave positive and negative
+    putVarint(buffer,(static_cast<unsigned long long>(value)<<1)^static_cast<unsigned long long>(value>>63));
+}
+
+static bool getVarint(const char *&p, const char *end, unsigned long long &value) {
+    //false if runs past end or too long
+    value=0;
+    for(int shift=0; shift<64; shift+=7){
+        if(p==end) return false;
+        unsigned char byte=*p++;
+        value|=static_cast<unsigned long long>(byte&0x7F)<<shift;
+        if(byte<0x80) return true;
+    }
+    return false;
+}
+
+static bool getZigzag(const char *&p, const char *end, long long &value) {
+    //undo interleave
+    unsigned long long u;
+    if(!getVarint(p,end,u)) return false;
+    value=static_cast<long long>(u>>1)^-static_cast<long long>(u&1);
+    return true;
+}
+
+static bool getCount(const char *&p, const char *end, int &value) {
+    //non-negative count which must fit in int
+    unsigned long long u;
+    if(!getVarint(p,end,u) || u>2147483647ULL) return false;
+    value=int(u);
+    return true;
+}
+
+//##### FRAME #####
+TrajectoryFrame::TrajectoryFrame() {
+    //empty keyframe
+    nRingsGrown=0;
+    key=true;
+    firstAtom=0;
+    firstRing=0;
+    ringOffsets.assign(1,0);
+}
+
+int TrajectoryFrame::nAtoms(int dim) const {
+    //from coordinates
+    return crds.size()/dim;
+}
+
+int TrajectoryFrame::nUnits() const {
+    //four atoms per unit
+    return unitAtoms.size()/4;
+}
+
+int TrajectoryFrame::nRings() const {
+    //rows of compressed ring units
+    return ringOffsets.empty() ? 0 : ringOffsets.size()-1;
+}
+
+//##### WRITER #####
+TrajectoryWriter::TrajectoryWriter() {
+    //default constructor
+    file=nullptr;
+    dim=0;
+    frameRings=0;
+    keyPending=true;
+    failed=false;
+    closing=false;
+}
+
+TrajectoryWriter::~TrajectoryWriter() {
+    //finish writing
+    close();
+}
+
+bool TrajectoryWriter::open(string filename, int dimensionality) {
+    //header of magic, endian tag, version, dimensions and coordinate resolution, then frames appended by background thread
+    close();
+    file=fopen(filename.c_str(),"wb");
+    if(file==nullptr) return false;
+    dim=dimensionality;
+    BinaryWriter header;
+    header.header(trajectoryMagic,trajectoryVersion);
+    header.put<int32_t>(dim);
+    header.put<double>(trajectoryQuantum);
+    failed=(fwrite(header.buffer.data(),1,header.buffer.size(),file)!=header.buffer.size());
+    frameAtomIds.clear();
+    frameRings=0;
+    keyPending=true;
+    frameCrds.clear();
+    frameUnits.clear();
+    closing=false;
+    worker=thread(&TrajectoryWriter::run,this);
+    return !failed;
+}
+
+bool TrajectoryWriter::isOpen() const {
+    //open until closed
+    return file!=nullptr;
+}
+
+void TrajectoryWriter::compacted(const vector<int> &updatedAtomIds) {
+    //follow atoms of previous frame through compaction, empty map if nothing removed
+    if(updatedAtomIds.empty()) return;
+    for(int i=0; i<frameAtomIds.size(); ++i){
+        if(frameAtomIds[i]>=0) frameAtomIds[i]=updatedAtomIds[frameAtomIds[i]];
+    }
+}
+
+void TrajectoryWriter::renumbered() {
+    //atoms of previous frame can no longer be followed
+    keyPending=true;
+}
+
+void TrajectoryWriter::begin(TrajectoryFrame &frame) {
+    //compaction is stable, so surviving atoms of previous frame keep order and new atoms follow them
+    frame.key=keyPending;
+    frame.removedAtoms.clear();
+    frame.firstAtom=0;
+    frame.firstRing=0;
+    if(frame.key) return;
+    for(int i=0; i<frameAtomIds.size(); ++i){
+        if(frameAtomIds[i]<0) frame.removedAtoms.push_back(i);
+        else ++frame.firstAtom;
+    }
+    frame.firstRing=frameRings;
+}
+
+void TrajectoryWriter::push(TrajectoryFrame &frame) {
+    //record ids of frame for next, then hand frame to background thread
+    int nAtoms=frame.nAtoms(dim);
+    frameAtomIds.resize(nAtoms);
+    for(int i=0; i<nAtoms; ++i) frameAtomIds[i]=i;
+    frameRings=frame.firstRing+frame.nRings();
+    keyPending=false;
+
+    unique_lock<mutex> guard(queueLock);
+    queueChanged.wait(guard,[this]{return queue.size()<trajectoryQueueLimit;});
+    queue.push_back(move(frame));
+    guard.unlock();
+    queueChanged.notify_all();
+}
+
+void TrajectoryWriter::run() {
+    //take frames in order until closed and queue empty, each record preceded by its length and flushed
+    vector<char> length;
+    for(;;){
+        unique_lock<mutex> guard(queueLock);
+        queueChanged.wait(guard,[this]{return !queue.empty() || closing;});
+        if(queue.empty()) break;
+        TrajectoryFrame frame=move(queue.front());
+        queue.pop_front();
+        guard.unlock();
+        queueChanged.notify_all();
+
+        encode(frame);
+        length.clear();
+        putVarint(length,record.size());
+        if(fwrite(length.data(),1,length.size(),file)!=length.size()) failed=true;
+        if(fwrite(record.data(),1,record.size(),file)!=record.size()) failed=true;
+        if(fflush(file)!=0) failed=true;
+    }
+}
+
+void TrajectoryWriter::encode(const TrajectoryFrame &frame) {
+    //key flag, rings grown, removed atoms, new atoms, changed coordinates, changed units, new units, new rings
+    //ids ascending so stored as gaps, coordinates of new atoms and ids of new units and rings stored relative to previous
+    record.clear();
+    record.push_back(frame.key ? 1 : 0);
+    putVarint(record,frame.nRingsGrown);
+    if(frame.key){
+        frameCrds.clear();
+        frameUnits.clear();
+    }
+
+    //removed atoms, previous frame compacted and unit atoms remapped to match
+    putVarint(record,frame.removedAtoms.size());
+    int prev=-1;
+    for(int i=0; i<frame.removedAtoms.size(); ++i){
+        putVarint(record,frame.removedAtoms[i]-prev-1);
+        prev=frame.removedAtoms[i];
+    }
+    if(frame.removedAtoms.size()>0){
+        int nFrameAtoms=frameCrds.size()/dim;
+        vector<int> updatedAtomIds(nFrameAtoms);
+        for(int i=0, k=0, aId=0; i<nFrameAtoms; ++i){
+            if(k<frame.removedAtoms.size() && frame.removedAtoms[k]==i){
+                updatedAtomIds[i]=-1;
+                ++k;
+            }
+            else{
+                for(int j=0; j<dim; ++j) frameCrds[dim*aId+j]=frameCrds[dim*i+j];
+                updatedAtomIds[i]=aId++;
+            }
+        }
+        frameCrds.resize(dim*(nFrameAtoms-frame.removedAtoms.size()));
+        for(int i=0; i<frameUnits.size(); ++i) frameUnits[i]=updatedAtomIds[frameUnits[i]];
+    }
+
+    //quantise coordinates
+    int nAtoms=frame.nAtoms(dim);
+    vector<long long> crds(dim*nAtoms);
+    for(int i=0; i<dim*nAtoms; ++i) crds[i]=llround(frame.crds[i]/trajectoryQuantum);
+
+    //new atoms
+    putVarint(record,nAtoms-frame.firstAtom);
+    for(int i=0; i<frame.elements.size(); ++i) putZigzag(record,frame.elements[i]);
+    for(int i=frame.firstAtom; i<nAtoms; ++i){
+        for(int j=0; j<dim; ++j) putZigzag(record,crds[dim*i+j]-(i>frame.firstAtom ? crds[dim*(i-1)+j] : 0));
+    }
+
+    //changed coordinates of existing atoms
+    vector<int> changed;
+    for(int i=0; i<frame.firstAtom; ++i){
+        for(int j=0; j<dim; ++j){
+            if(crds[dim*i+j]!=frameCrds[dim*i+j]){
+                changed.push_back(i);
+                break;
+            }
+        }
+    }
+    putVarint(record,changed.size());
+    prev=-1;
+    for(int i=0; i<changed.size(); ++i){
+        putVarint(record,changed[i]-prev-1);
+        prev=changed[i];
+        for(int j=0; j<dim; ++j) putZigzag(record,crds[dim*prev+j]-frameCrds[dim*prev+j]);
+    }
+
+    //changed units, then new units with x atoms relative to m atom
+    int nFrameUnits=frameUnits.size()/4, nUnits=frame.nUnits();
+    changed.clear();
+    for(int i=0; i<nFrameUnits; ++i){
+        for(int j=0; j<4; ++j){
+            if(frame.unitAtoms[4*i+j]!=frameUnits[4*i+j]){
+                changed.push_back(i);
+                break;
+            }
+        }
+    }
+    putVarint(record,changed.size());
+    prev=-1;
+    for(int i=0; i<changed.size(); ++i){
+        putVarint(record,changed[i]-prev-1);
+        prev=changed[i];
+        for(int j=0; j<4; ++j) putVarint(record,frame.unitAtoms[4*prev+j]);
+    }
+    putVarint(record,nUnits-nFrameUnits);
+    prev=0;
+    for(int i=nFrameUnits; i<nUnits; ++i){
+        int m=frame.unitAtoms[4*i];
+        putZigzag(record,m-prev);
+        for(int j=1; j<4; ++j) putZigzag(record,frame.unitAtoms[4*i+j]-m);
+        prev=m;
+    }
+
+    //new rings
+    putVarint(record,frame.nRings());
+    prev=0;
+    for(int i=0; i<frame.nRings(); ++i){
+        putVarint(record,frame.ringOffsets[i+1]-frame.ringOffsets[i]);
+        for(int j=frame.ringOffsets[i]; j<frame.ringOffsets[i+1]; ++j){
+            putZigzag(record,frame.ringUnits[j]-prev);
+            prev=frame.ringUnits[j];
+        }
+    }
+
+    frameCrds.swap(crds);
+    frameUnits=frame.unitAtoms;
+}
+
+bool TrajectoryWriter::close() {
+    //let background thread drain queue, then close file
+    if(file==nullptr) return !failed;
+    {
+        lock_guard<mutex> guard(queueLock);
+        closing=true;
+    }
+    queueChanged.notify_all();
+    worker.join();
+    if(fclose(file)!=0) failed=true;
+    file=nullptr;
+    return !failed;
+}
+
+//##### READER #####
+TrajectoryReader::TrajectoryReader() {
+    //default constructor
+    dim=0;
+    quantum=0.0;
+    nRingsGrown=0;
+    replayFrame=-1;
+}
+
+bool TrajectoryReader::open(string filename) {
+    //check header then find extent of each frame
+    recordStarts.clear();
+    recordEnds.clear();
+    recordKey.clear();
+    replayFrame=-1;
+    uint32_t version;
+    if(!reader.read(filename) || !reader.header(trajectoryMagic,version) || version!=trajectoryVersion) return false;
+    dim=reader.get<int32_t>();
+    quantum=reader.get<double>();
+    if(!reader.valid || dim<2 || dim>3 || !(quantum>0.0)) return false;
+
+    const char *begin=reader.buffer.data(), *end=begin+reader.buffer.size();
+    const char *p=begin+reader.position;
+    unsigned long long length;
+    while(p<end){
+        if(!getVarint(p,end,length) || length==0 || length>size_t(end-p)) break;
+        recordStarts.push_back(p-begin);
+        recordEnds.push_back(p-begin+length);
+        recordKey.push_back(*p!=0);
+        p+=length;
+    }
+    return recordKey.empty() || recordKey[0];
+}
+
+int TrajectoryReader::nFrames() const {
+    //complete frames
+    return recordKey.size();
+}
+
+int TrajectoryReader::dimensionality() const {
+    //coordinate dimensions
+    return dim;
+}
+
+bool TrajectoryReader::isKey(int f) const {
+    //whole network held
+    return recordKey[f];
+}
+
+bool TrajectoryReader::apply(int f) {
+    //mirror of encoding, ids checked against counts so malformed frame cannot index out of range
+    const char *p=reader.buffer.data()+recordStarts[f], *end=reader.buffer.data()+recordEnds[f];
+    bool key=(*p++!=0);
+    if(key){
+        elements.clear();
+        crds.clear();
+        unitAtoms.clear();
+        ringOffsets.assign(1,0);
+        ringUnits.clear();
+    }
+    if(!getCount(p,end,nRingsGrown)) return false;
+
+    //removed atoms, units holding them must be among changed units
+    int n, gap, nAtoms=elements.size();
+    if(!getCount(p,end,n) || n>nAtoms) return false;
+    if(n>0){
+        vector<int> updatedAtomIds(nAtoms,0);
+        for(int i=0, prev=-1; i<n; ++i){
+            if(!getCount(p,end,gap) || gap>=nAtoms-prev-1) return false;
+            prev+=gap+1;
+            updatedAtomIds[prev]=-1;
+        }
+        int aId=0;
+        for(int i=0; i<nAtoms; ++i){
+            if(updatedAtomIds[i]==-1) continue;
+            elements[aId]=elements[i];
+            for(int j=0; j<dim; ++j) crds[dim*aId+j]=crds[dim*i+j];
+            updatedAtomIds[i]=aId++;
+        }
+        nAtoms=aId;
+        elements.resize(nAtoms);
+        crds.resize(dim*nAtoms);
+        for(int i=0; i<unitAtoms.size(); ++i) unitAtoms[i]=updatedAtomIds[unitAtoms[i]];
+    }
+
+    //new atoms
+    long long v;
+    if(!getCount(p,end,n) || n>end-p) return false;
+    for(int i=0; i<n; ++i){
+        if(!getZigzag(p,end,v)) return false;
+        elements.push_back(int(v));
+    }
+    for(int i=0; i<n; ++i){
+        for(int j=0; j<dim; ++j){
+            if(!getZigzag(p,end,v)) return false;
+            crds.push_back(v+(i>0 ? crds[dim*(nAtoms+i-1)+j] : 0));
+        }
+    }
+    int nExisting=nAtoms;
+    nAtoms+=n;
+
+    //changed coordinates
+    if(!getCount(p,end,n)) return false;
+    for(int i=0, prev=-1; i<n; ++i){
+        if(!getCount(p,end,gap) || gap>=nExisting-prev-1) return false;
+        prev+=gap+1;
+        for(int j=0; j<dim; ++j){
+            if(!getZigzag(p,end,v)) return false;
+            crds[dim*prev+j]+=v;
+        }
+    }
+
+    //changed and new units
+    int nUnits=unitAtoms.size()/4, a;
+    if(!getCount(p,end,n)) return false;
+    for(int i=0, prev=-1; i<n; ++i){
+        if(!getCount(p,end,gap) || gap>=nUnits-prev-1) return false;
+        prev+=gap+1;
+        for(int j=0; j<4; ++j){
+            if(!getCount(p,end,a) || a>=nAtoms) return false;
+            unitAtoms[4*prev+j]=a;
+        }
+    }
+    for(int i=0; i<unitAtoms.size(); ++i) if(unitAtoms[i]<0) return false; //unit left holding removed atom
+    if(!getCount(p,end,n) || n>end-p) return false;
+    for(int i=0, m=0; i<n; ++i){
+        if(!getZigzag(p,end,v)) return false;
+        m+=v;
+        if(m<0 || m>=nAtoms) return false;
+        unitAtoms.push_back(m);
+        for(int j=1; j<4; ++j){
+            if(!getZigzag(p,end,v) || m+v<0 || m+v>=nAtoms) return false;
+            unitAtoms.push_back(m+v);
+        }
+    }
+    nUnits+=n;
+
+    //new rings
+    int size;
+    if(!getCount(p,end,n) || n>end-p) return false;
+    for(int i=0, u=0; i<n; ++i){
+        if(!getCount(p,end,size) || size>end-p) return false;
+        for(int j=0; j<size; ++j){
+            if(!getZigzag(p,end,v)) return false;
+            u+=v;
+            if(u<0 || u>=nUnits) return false;
+            ringUnits.push_back(u);
+        }
+        ringOffsets.push_back(ringUnits.size());
+    }
+    return p==end;
+}
+
+bool TrajectoryReader::frame(int f, TrajectoryFrame &state) {
+    //replay from preceding keyframe, or from current state if already between keyframe and frame
+    if(f<0 || f>=nFrames()) return false;
+    int k=f;
+    while(!recordKey[k]) --k;
+    if(replayFrame<k || replayFrame>f) replayFrame=k-1;
+    for(int i=replayFrame+1; i<=f; ++i){
+        if(!apply(i)){
+            replayFrame=-1;
+            return false;
+        }
+        replayFrame=i;
+    }
+
+    state.nRingsGrown=nRingsGrown;
+    state.key=true;
+    state.firstAtom=0;
+    state.firstRing=0;
+    state.removedAtoms.clear();
+    state.elements=elements;
+    state.crds.resize(crds.size());
+    for(int i=0; i<crds.size(); ++i) state.crds[i]=crds[i]*quantum;
+    state.unitAtoms=unitAtoms;
+    state.ringOffsets=ringOffsets;
+    state.ringUnits=ringUnits;
+    return true;
+}
@@ -0,0 +1,122 @@
+//Growth trajectory, frames appended to stream as network grows and read back to reconstruct any frame.
+//Keyframes hold whole network, other frames only changes since previous frame: atoms removed by compaction, new atoms,
+//quantised coordinate changes, changed and new units and new rings, with integers variable length so small values are short.
+//Growth thread only copies network into frame, encoding and writing done on background thread.
+#ifndef MX2_TRAJECTORY_H
+#define MX2_TRAJECTORY_H
+
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <cmath>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "binaryIO.h"
+
+using namespace std;
+
+const char trajectoryMagic[]="MX2T"; //first bytes of trajectory stream
+const uint32_t trajectoryVersion=1; //version of trajectory layout
+const string trajectorySuffix="_trajectory.bin"; //trajectory file name after prefix
+const double trajectoryQuantum=1.0e-5; //resolution of stored coordinates
+const int trajectoryQueueLimit=4; //frames waiting to be written before growth waits
+
+struct TrajectoryFrame {
+    //network state, atoms and rings from first new ids onward, all coordinates and units
+
+    int nRingsGrown; //rings in network when captured
+    bool key; //whole network rather than changes since previous frame
+    int firstAtom, firstRing; //first atom and ring added since previous frame, 0 for keyframe
+    vector<int> removedAtoms; //atoms of previous frame since removed, in ascending previous frame ids
+    vector<int> elements; //elements of atoms from first atom
+    vector<double> crds; //coordinates of all atoms
+    vector<int> unitAtoms; //m then three x atoms of every unit
+    vector<int> ringOffsets, ringUnits; //units of rings from first ring, compressed rows
+
+    //constructors
+    TrajectoryFrame();
+
+    //methods
+    int nAtoms(int dim) const; //number of atoms
+    int nUnits() const; //number of units
+    int nRings() const; //number of rings held
+};
+
+class TrajectoryWriter {
+    //captures frames in growth thread and encodes and appends them to file in background thread
+
+private:
+    FILE *file; //output stream, null if not open
+    int dim; //coordinate dimensions
+    //capture state, growth thread
+    vector<int> frameAtomIds; //current id of each atom of previous frame, -1 if removed
+    int frameRings; //number of rings in previous frame
+    bool keyPending; //ids renumbered, next frame must be keyframe
+    //encoding state, background thread
+    vector<long long> frameCrds; //quantised coordinates of previous frame
+    vector<int> frameUnits; //unit atoms of previous frame
+    vector<char> record; //encoded frame
+    bool failed; //any write failed
+    //hand over
+    thread worker;
+    mutex queueLock;
+    condition_variable queueChanged;
+    deque<TrajectoryFrame> queue;
+    bool closing;
+
+    void run(); //background loop writing queued frames
+    void encode(const TrajectoryFrame &frame); //encode frame into record, updating previous frame
+
+public:
+    //constructors, destructor
+    TrajectoryWriter();
+    ~TrajectoryWriter();
+    TrajectoryWriter(const TrajectoryWriter&)=delete;
+    TrajectoryWriter& operator=(const TrajectoryWriter&)=delete;
+
+    //methods
+    bool open(string filename, int dimensionality); //write header and start background thread, false if cannot
+    bool isOpen() const;
+    void compacted(const vector<int> &updatedAtomIds); //atoms removed and ids shifted down, new id of each atom or -1
+    void renumbered(); //ids permuted, next frame written whole
+    void begin(TrajectoryFrame &frame); //set which atoms and rings frame must hold
+    void push(TrajectoryFrame &frame); //queue frame for writing, waits if queue full
+    bool close(); //write remaining frames and close file, false if any write failed
+};
+
+class TrajectoryReader {
+    //indexes frames of trajectory then reconstructs any frame by replaying from preceding keyframe
+
+private:
+    BinaryReader reader; //whole file
+    int dim; //coordinate dimensions
+    double quantum; //resolution of stored coordinates
+    vector<size_t> recordStarts, recordEnds; //payload of each frame
+    vector<bool> recordKey; //frame is keyframe
+
+    //replay state
+    vector<int> elements;
+    vector<long long> crds;
+    vector<int> unitAtoms, ringOffsets, ringUnits;
+    int nRingsGrown;
+    int replayFrame; //frame held in replay state, -1 if none
+
+    bool apply(int f); //decode frame onto replay state, false if malformed
+
+public:
+    //constructors
+    TrajectoryReader();
+
+    //methods
+    bool open(string filename); //read and index file, false if not trajectory, incomplete final frame ignored
+    int nFrames() const;
+    int dimensionality() const;
+    bool isKey(int f) const;
+    bool frame(int f, TrajectoryFrame &state); //reconstruct frame as keyframe, false if malformed
+};
+
+#endif //MX2_TRAJECTORY_H
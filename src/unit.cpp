@@ -6,12 +6,10 @@ Unit::Unit(){
     id=-1;
 }
 
-Unit::Unit(int idValue, int maxX, int maxU, int maxR) {
+Unit::Unit(int idValue) {
     //constructor
     id=idValue;
-    atomsX=Connector(maxX);
-    units=Connector(maxU);
-    rings=Connector(maxR);
+    atomM=-1;
     flag=false;
 }
 
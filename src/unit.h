@@ -9,13 +9,13 @@ using namespace std;
 struct Unit {
     //contains connectivity information to atoms, units and rings
 
-    int id; //unique identifier
-    int atomM; //metal atom
-    Connector atomsX, units, rings; //connections
+    int32_t id; //unique identifier
+    int32_t atomM; //metal atom
+    FixedConnector<3> atomsX, units, rings; //connections, arity fixed so held inline
     bool flag; //generic flag
 
     Unit(); //constructor
-    Unit(int idValue, int maxX, int maxU, int maxR); //constructor
+    Unit(int idValue); //constructor
 
     void setAtomM(int m);
 };